@@ -0,0 +1,69 @@
+#pragma once
+
+#include <blib/util/FileSystem.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+//reads little endian values from a file that has been loaded into memory at once. Reading past the end gives zeroes,
+//so parsers can check remaining() once for a whole section and then decode its records in a tight loop
+class BufferReader
+{
+	const char* data;
+	size_t size;
+	size_t pos;
+public:
+	BufferReader(const char* data, size_t size) : data(data), size(size), pos(0) {}
+	BufferReader(const std::vector<char> &buffer) : data(buffer.data()), size(buffer.size()), pos(0) {}
+
+	//reads the rest of a file into a buffer
+	static void readAll(blib::util::StreamInFile* file, std::vector<char> &buffer)
+	{
+		buffer.clear();
+		char chunk[64 * 1024];
+		while (!file->eof())
+		{
+			unsigned int len = file->read(chunk, sizeof(chunk));
+			if (len == 0)
+				break;
+			buffer.insert(buffer.end(), chunk, chunk + len);
+		}
+	}
+
+	inline size_t remaining() const { return size - pos; }
+	inline size_t tell() const { return pos; }
+	inline const char* current() const { return data + pos; }
+	inline void skip(size_t count) { pos += count < remaining() ? count : remaining(); }
+
+	inline void read(void* dest, size_t count)
+	{
+		if (count == 0)
+			return;
+		size_t len = count < remaining() ? count : remaining();
+		memcpy(dest, data + pos, len);
+		memset((char*)dest + len, 0, count - len);
+		pos += len;
+	}
+	template<class T> inline T readValue() { T value; read(&value, sizeof(T)); return value; }
+
+	inline char get() { return readValue<char>(); }
+	inline short readShort() { return readValue<short>(); }
+	inline short readWord() { return readValue<short>(); }
+	inline unsigned short readUWord() { return readValue<unsigned short>(); }
+	inline int readInt() { return readValue<int>(); }
+	inline float readFloat() { return readValue<float>(); }
+	inline glm::vec2 readVec2() { return readValue<glm::vec2>(); }
+	inline glm::vec3 readVec3() { return readValue<glm::vec3>(); }
+
+	//reads a fixed size, zero padded string
+	inline std::string readString(size_t length)
+	{
+		const char* begin = current();
+		size_t len = length < remaining() ? length : remaining();
+		std::string ret(begin, strnlen(begin, len));
+		skip(length);
+		return ret;
+	}
+};
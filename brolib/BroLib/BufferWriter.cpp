@@ -0,0 +1,35 @@
+#include "BufferWriter.h"
+
+#include <blib/util/Log.h>
+using blib::util::Log;
+
+#include <cstdio>
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+bool BufferWriter::save(const std::string &fileName) const
+{
+	std::string tmpFile = fileName + ".tmp";
+	FILE* file = fopen(tmpFile.c_str(), "wb");
+	if (!file)
+	{
+		Log::err << "Unable to open " << tmpFile << " for writing" << Log::newline;
+		return false;
+	}
+	bool ok = buffer.empty() || fwrite(buffer.data(), buffer.size(), 1, file) == 1;
+	ok = fflush(file) == 0 && ok;
+	ok = fclose(file) == 0 && ok;
+	//replacing the file has to be a single step, std::rename doesn't overwrite existing files on windows
+#ifdef WIN32
+	ok = ok && MoveFileExA(tmpFile.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	ok = ok && std::rename(tmpFile.c_str(), fileName.c_str()) == 0;
+#endif
+	if (!ok)
+	{
+		std::remove(tmpFile.c_str());
+		Log::err << "Unable to write " << fileName << Log::newline;
+	}
+	return ok;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+//writes little endian values into a buffer in memory, the counterpart of BufferReader. The savers serialize a whole file
+//into one of these, so the file can be written with a single write, away from the main thread
+class BufferWriter
+{
+	std::vector<char> buffer;
+public:
+	inline size_t size() const { return buffer.size(); }
+	inline const std::vector<char>& data() const { return buffer; }
+
+	inline void write(const void* src, size_t count)
+	{
+		if (count == 0)
+			return;
+		size_t pos = buffer.size();
+		buffer.resize(pos + count);
+		memcpy(&buffer[pos], src, count);
+	}
+	template<class T> inline void writeValue(const T &value) { write(&value, sizeof(T)); }
+
+	inline void put(char value) { buffer.push_back(value); }
+	inline void writeShort(short value) { writeValue(value); }
+	inline void writeUWord(unsigned short value) { writeValue(value); }
+	inline void writeInt(int value) { writeValue(value); }
+	inline void writeFloat(float value) { writeValue(value); }
+	inline void writeVec3(const glm::vec3 &value) { writeValue(value); }
+
+	//writes a fixed size, zero padded string
+	inline void writeString(const std::string &value, size_t length)
+	{
+		size_t pos = buffer.size();
+		buffer.resize(pos + length, 0);
+		memcpy(&buffer[pos], value.c_str(), value.size() < length ? value.size() : length);
+	}
+
+	//writes the buffer to a temporary file next to fileName, and then moves it over fileName. The old file stays intact
+	//until the new one is completely on disk, so a crash or a full disk never leaves a truncated file behind
+	bool save(const std::string &fileName) const;
+};
@@ -1,31 +1,41 @@
-#pragma once
-
-#include <vector>
-#include <string>
-
-
-class Gat
-{
-public:
-	class Tile
-	{
-	public:
-		float heights[4];
-		int type;
-		bool selected;
-	};
-	int version;
-	int width;
-	int height;
-	std::vector<std::vector<Tile*>> tiles;
-
-
-
-
-	Gat(const std::string &fileName);
-	Gat(int width, int height);
-	~Gat();
-
-	void save(const std::string &fileName);
-
+#pragma once
+
+#include <vector>
+#include <string>
+
+class BufferWriter;
+
+
+class Gat
+{
+public:
+	//a tile is laid out exactly like the 20 byte record in the gat file
+	class Tile
+	{
+	public:
+		float heights[4];
+		int type;
+	};
+	static_assert(sizeof(Tile) == 20, "Gat tiles need to match the file records");
+
+	int version;
+	int width;
+	int height;
+
+	//the tiles are stored row-major (index x + width * y), in the same order as the file
+	std::vector<Tile> tiles;
+	std::vector<bool> tileSelection;
+
+	inline int tileIndex(int x, int y) const { return x + width * y; }
+	inline Tile& tile(int x, int y) { return tiles[tileIndex(x, y)]; }
+	inline std::vector<bool>::reference selected(int x, int y) { return tileSelection[tileIndex(x, y)]; }
+
+
+	Gat(const std::string &fileName);
+	Gat(int width, int height);
+	~Gat();
+
+	void save(const std::string &fileName);
+	void save(BufferWriter &writer) const;
+
 };
\ No newline at end of file
@@ -1,683 +1,922 @@
-#include "Gnd.h"
-
-#include <set>
-
-#include <blib/util/FileSystem.h>
-#include <blib/util/Log.h>
-#include <blib/linq.h>
-#include <blib/Texture.h>
-#include <blib/ResourceManager.h>
-using blib::util::Log;
-
-Gnd::Gnd(int width, int height)
-{
-	version = 0x0107;
-	this->width = width;
-	this->height = height;
-	tileScale = 10.0f;
-	maxTexName = 80;
-	lightmapWidth = 8;
-	lightmapHeight = 8;
-	gridSizeCell = 1;
-
-
-	cubes.resize(width, std::vector<Cube*>(height, NULL));
-	for (int y = 0; y < height; y++)
-	{
-		for (int x = 0; x < width; x++)
-		{
-			Cube* cube = new Cube();
-			cube->h1 = cube->h2 = cube->h3 = cube->h4 = 0;
-			cube->tileUp = -1;
-			cube->tileSide = -1;
-			cube->tileFront = -1;
-			cube->calcNormal();
-			cubes[x][y] = cube;
-		}
-	}
-}
-
-
-
-Gnd::Gnd( const std::string &fileName )
-{
-	blib::util::StreamInFile* file = blib::util::FileSystem::openRead(fileName + ".gnd");
-	if(!file || !file->opened())
-	{
-		width = 0;
-		height = 0;
-		Log::err<<"GND: Unable to open gnd file: "<<fileName<<".gnd"<<Log::newline;
-		return;
-	}
-	Log::out<<"GND: Reading gnd file"<<Log::newline;
-	char header[4];
-	file->read(header, 4);
-	if(header[0] == 'G' && header[1] == 'R' && header[2] == 'G' && header[3] == 'N')
-		version = file->readShort();
-	else
-	{
-		version = 0;
-		Log::out << "GND: Invalid GND file" << Log::newline;
-	}
-
-	int textureCount = 0;
-
-	if(version > 0)
-	{
-		width = file->readInt();
-		height = file->readInt();
-		tileScale = file->readFloat();
-		textureCount = file->readInt();
-		maxTexName = file->readInt();// 80
-	}
-	else
-	{
-		file->seek(6, blib::util::StreamSeekable::CURRENT);//TODO: test this
-		width = file->readInt();
-		height = file->readInt();
-		textureCount = file->readInt();
-	}
-
-
-	textures.reserve(textureCount);
-	for(int i = 0; i < textureCount; i++)
-	{
-		Texture* texture = new Texture();
-		texture->file = file->readString(40);
-		texture->name = file->readString(40);
-
-		//texture->texture = new Texture("data/texture/" + texture->file); //TODO: blib loader
-
-		textures.push_back(texture);
-	}
-
-
-	if(version > 0)
-	{
-		int lightmapCount = file->readInt();
-		lightmapWidth = file->readInt();
-		lightmapHeight = file->readInt();
-		gridSizeCell = file->readInt();
-
-		//Fix lightmap format if it was invalid. by Henko
-		if (lightmapWidth != 8 || lightmapHeight != 8 || gridSizeCell != 1)
-		{
-			Log::err<<"GND: Invalid Lightmap Format in "<<fileName<<".gnd"<<Log::newline;
-			lightmapWidth = 8;
-			lightmapHeight = 8;
-			gridSizeCell = 1;
-		}
-
-		lightmaps.reserve(lightmapCount);
-		for(int i = 0; i < lightmapCount; i++)
-		{
-			Lightmap* lightmap = new Lightmap();
-			file->read((char*)lightmap->data, 256);
-			lightmaps.push_back(lightmap);
-		}
-
-		int tileCount = file->readInt();
-		Log::out << "Tilecount: " << tileCount << Log::newline;
-		tiles.reserve(tileCount);
-		for(int i = 0; i < tileCount; i++)
-		{
-			Tile* tile = new Tile();
-
-			tile->v1.x = file->readFloat();
-			tile->v2.x = file->readFloat();
-			tile->v3.x = file->readFloat();
-			tile->v4.x = file->readFloat();
-			tile->v1.y = file->readFloat();
-			tile->v2.y = file->readFloat();
-			tile->v3.y = file->readFloat();
-			tile->v4.y = file->readFloat();
-			tile->textureIndex = file->readWord();
-			tile->lightmapIndex= file->readUWord();
-
-
-			if (tile->lightmapIndex < 0 || tile->lightmapIndex == (unsigned short)-1)
-			{
-				Log::out << "Lightmapindex < 0" << Log::newline;
-				tile->lightmapIndex = 0;
-			}
-
-
-
-			tile->color.b = (unsigned char)file->get();
-			tile->color.g = (unsigned char)file->get();
-			tile->color.r = (unsigned char)file->get();
-			tile->color.a = (unsigned char)file->get();
-			tiles.push_back(tile);
-		}
-
-
-
-
-		cubes.resize(width, std::vector<Cube*>(height, NULL));
-		for(int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				Cube* cube = new Cube();
-				cube->h1 = file->readFloat();
-				cube->h2 = file->readFloat();
-				cube->h3 = file->readFloat();
-				cube->h4 = file->readFloat();
-				cube->calcNormal();
-
-				if (version >= 0x0106)
-				{
-					cube->tileUp = file->readInt();
-					cube->tileSide = file->readInt();
-					cube->tileFront = file->readInt();
-				}
-				else
-				{
-					cube->tileUp = file->readUWord();
-					cube->tileSide = file->readUWord();
-					cube->tileFront = file->readUWord();
-				}
-
-				if (cube->tileUp >= (int)tiles.size())
-				{
-					Log::out << "Wrong value for tileup at " << x << ", " << y << Log::newline;
-					cube->tileUp = -1;
-				}
-				if (cube->tileSide >= (int)tiles.size())
-				{
-					Log::out << "Wrong value for tileside at " << x << ", " << y << Log::newline;
-					cube->tileSide = -1;
-				}
-				if (cube->tileFront >= (int)tiles.size())
-				{
-					Log::out << "Wrong value for tilefront at " << x << ", " << y << Log::newline;
-					cube->tileFront = -1;
-				}
-
-				cubes[x][y] = cube;
-			}
-		}
-	}
-	else
-	{
-		//TODO: port code...too lazy for now
-	}
-	delete file;
-	Log::out<<"GND: Done reading gnd file"<<Log::newline;
-
-	for (int x = 1; x < width-1; x++)
-	{
-		for (int y = 1; y < height-1; y++)
-		{
-			cubes[x][y]->calcNormals(this, x, y);
-		}
-	}
-	Log::out<<"GND: Done calculating normals" << Log::newline;
-}
-
-Gnd::~Gnd()
-{
-	blib::linq::deleteall(textures);
-	blib::linq::deleteall(lightmaps);
-	blib::linq::deleteall(tiles);
-
-	for (size_t i = 0; i < cubes.size(); i++)
-		for (size_t ii = 0; ii < cubes[i].size(); ii++)
-			if (cubes[i][ii])
-				delete cubes[i][ii];
-
-}
-
-
-
-
-void Gnd::save(std::string fileName)
-{
-	blib::util::PhysicalFileSystemHandler::StreamOutFilePhysical* pFile = new blib::util::PhysicalFileSystemHandler::StreamOutFilePhysical(fileName + ".gnd");
-
-
-	char header[5] = "GRGN";
-	pFile->write(header, 4);
-	pFile->writeShort(version);
-
-	if (version > 0)
-	{
-		pFile->writeInt(width);
-		pFile->writeInt(height);
-		pFile->writeFloat(tileScale);
-		pFile->writeInt(textures.size());
-		pFile->writeInt(maxTexName);// iunno
-	}
-	
-	
-	for (size_t i = 0; i < textures.size(); i++)
-	{
-		pFile->writeString(textures[i]->file, 40);
-		pFile->writeString(textures[i]->name, 40);
-	}
-
-
-	if (version > 0)
-	{
-		pFile->writeInt(lightmaps.size());
-		pFile->writeInt(lightmapWidth);
-		pFile->writeInt(lightmapHeight);
-		pFile->writeInt(gridSizeCell);
-
-		for (size_t i = 0; i < lightmaps.size(); i++)
-			pFile->write((char*)lightmaps[i]->data, 256);
-
-		pFile->writeInt(tiles.size());
-		for (size_t i = 0; i < tiles.size(); i++)
-		{
-			Tile* tile = tiles[i];
-
-			pFile->writeFloat(tile->v1.x);
-			pFile->writeFloat(tile->v2.x);
-			pFile->writeFloat(tile->v3.x);
-			pFile->writeFloat(tile->v4.x);
-			pFile->writeFloat(tile->v1.y);
-			pFile->writeFloat(tile->v2.y);
-			pFile->writeFloat(tile->v3.y);
-			pFile->writeFloat(tile->v4.y);
-			pFile->writeUWord(tile->textureIndex);
-			pFile->writeUWord(tile->lightmapIndex);
-	
-			pFile->put(tile->color.b);
-			pFile->put(tile->color.g);
-			pFile->put(tile->color.r);
-			pFile->put(tile->color.a);
-		}
-
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				Cube* cube = cubes[x][y];
-				pFile->writeFloat(cube->h1);
-				pFile->writeFloat(cube->h2);
-				pFile->writeFloat(cube->h3);
-				pFile->writeFloat(cube->h4);
-				if (version >= 0x0106)
-				{
-					pFile->writeInt(cube->tileUp);
-					pFile->writeInt(cube->tileSide);
-					pFile->writeInt(cube->tileFront);
-				}
-				else
-				{
-					pFile->writeUWord(cube->tileUp);
-					pFile->writeUWord(cube->tileSide);
-					pFile->writeUWord(cube->tileFront);
-				}
-			}
-		}
-
-
-	}
-
-
-	delete pFile;
-}
-
-
-Gnd::Texture::Texture()
-{
-	texture = NULL;
-}
-
-Gnd::Texture::~Texture()
-{
-	if(texture)
-		blib::ResourceManager::getInstance().dispose(texture);
-	texture = NULL;
-}
-
-void Gnd::Cube::calcNormal()
-{
-/*
-	1----2
-	|\   |
-	| \  |
-	|  \ |
-	|   \|
-	3----4
-*/
-	glm::vec3 v1(10, -h1, 0);
-	glm::vec3 v2(0, -h2, 0);
-	glm::vec3 v3(10, -h3, 10);
-	glm::vec3 v4(0, -h4, 10);
-
-	glm::vec3 normal1 = glm::normalize(glm::cross(v4 - v3, v1 - v3));
-	glm::vec3 normal2 = glm::normalize(glm::cross(v1 - v2, v4 - v2));
-	normal = glm::normalize(normal1 + normal2);
-	for (int i = 0; i < 4; i++)
-		normals[i] = normal;
-}
-
-
-void Gnd::Cube::calcNormals(Gnd* gnd, int x, int y)
-{
-	for (int i = 0; i < 4; i++)
-	{
-		normals[i] = glm::vec3(0, 0, 0);
-		for (int ii = 0; ii < 4; ii++)
-		{
-			int xx = (ii % 2) * ((i % 2 == 0) ? -1 : 1);
-			int yy = (ii / 2) * (i < 2 ? -1 : 1);
-			if (x+xx >= 0 && x+xx < gnd->width && y+yy >= 0 && y+yy < gnd->height)
-				normals[i] += gnd->cubes[x + xx][y + yy]->normal;
-		}
-		normals[i] = glm::normalize(normals[i]);
-	}
-}
-
-
-void Gnd::makeLightmapsUnique()
-{
-	std::set<int> taken;
-	for (int y = 0; y < height; y++)
-	{
-		for (int x = 0; x < width; x++)
-		{
-			if (cubes[x][y]->tileUp == -1)
-				continue;
-			if (taken.find(cubes[x][y]->tileUp) == taken.end())
-				taken.insert(cubes[x][y]->tileUp);
-			else
-			{
-				Tile* t = new Tile(*tiles[cubes[x][y]->tileUp]);
-				cubes[x][y]->tileUp = tiles.size();
-				tiles.push_back(t);
-			}
-		}
-	}
-	taken.clear();
-	for (Tile* t : tiles)
-	{
-		if (taken.find(t->lightmapIndex) == taken.end())
-			taken.insert(t->lightmapIndex);
-		else
-		{
-			Lightmap* l = new Lightmap(*lightmaps[t->lightmapIndex]);
-			t->lightmapIndex = lightmaps.size();
-			lightmaps.push_back(l);
-		}
-	}
-}
-
-void Gnd::makeLightmapBorders()
-{
-	makeLightmapsUnique();
-	Log::out << "Fixing borders" << Log::newline;
-	for (int x = 0; x < width; x++)
-	{
-		for (int y = 0; y < height; y++)
-		{
-			Gnd::Cube* cube = cubes[x][y];
-			int tileId = cube->tileUp;
-			if (tileId != -1)
-			{
-				Gnd::Tile* tile = tiles[tileId];
-				assert(tile && tile->lightmapIndex != -1);
-				Gnd::Lightmap* lightmap = lightmaps[tile->lightmapIndex];
-
-				for (int i = 0; i < 8; i++)
-				{
-					lightmap->data[i + 8 * 0] = getLightmapBrightness(x, y - 1, i, 6);
-					lightmap->data[i + 8 * 7] = getLightmapBrightness(x, y + 1, i, 1);
-					lightmap->data[0 + 8 * i] = getLightmapBrightness(x - 1, y, 6, i);
-					lightmap->data[7 + 8 * i] = getLightmapBrightness(x + 1, y, 1, i);
-
-					for (int c = 0; c < 3; c++)
-					{
-						lightmap->data[64 + 3 * (i + 8 * 0) + c] = getLightmapColor(x, y - 1, i, 6)[c];
-						lightmap->data[64 + 3 * (i + 8 * 7) + c] = getLightmapColor(x, y + 1, i, 1)[c];
-						lightmap->data[64 + 3 * (0 + 8 * i) + c] = getLightmapColor(x - 1, y, 6, i)[c];
-						lightmap->data[64 + 3 * (7 + 8 * i) + c] = getLightmapColor(x + 1, y, 1, i)[c];
-
-					}
-
-				}
-			}
-			tileId = cube->tileSide;
-			if (tileId != -1)
-			{
-				Gnd::Tile* tile = tiles[tileId];
-				assert(tile && tile->lightmapIndex != -1);
-				Gnd::Lightmap* lightmap = lightmaps[tile->lightmapIndex];
-
-				auto otherCube = cubes[x-1][y];
-				if (otherCube->tileSide != -1)
-				{
-					auto otherTile = tiles[otherCube->tileSide];
-					auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-					for (int i = 0; i < 8; i++)
-						lightmap->data[0 + 8 * i] = otherLightmap->data[6 + 8 * i];
-				}
-				else
-					for (int i = 0; i < 8; i++)
-						lightmap->data[0 + 8 * i] = lightmap->data[1 + 8 * i];
-
-				otherCube = cubes[x+1][y];
-				if (otherCube->tileSide != -1)
-				{
-					auto otherTile = tiles[otherCube->tileSide];
-					auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-					for (int i = 0; i < 8; i++)
-						lightmap->data[7 + 8 * i] = otherLightmap->data[1 + 8 * i];
-				}
-				else
-					for (int i = 0; i < 8; i++)
-						lightmap->data[7 + 8 * i] = lightmap->data[6 + 8 * i];
-
-				//top and bottom
-				otherCube = cubes[x][y+1];
-				if (otherCube->tileUp != -1)
-				{
-					auto otherTile = tiles[otherCube->tileUp];
-					auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-					for (int i = 0; i < 8; i++)
-						lightmap->data[i + 8 * 7] = otherLightmap->data[i + 8 * 1]; //bottom
-				}
-				else
-					for (int i = 0; i < 8; i++)
-						lightmap->data[i + 8 * 7] = lightmap->data[i + 8 * 6];
-
-
-				otherCube = cubes[x][y];
-				if (otherCube->tileUp != -1)
-				{
-					auto otherTile = tiles[otherCube->tileUp];
-					auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-					for (int i = 0; i < 8; i++)
-						lightmap->data[i + 8 * 0] = otherLightmap->data[i + 8 * 1]; //bottom
-				}
-				else
-					for (int i = 0; i < 8; i++)
-						lightmap->data[i + 8 * 0] = lightmap->data[i + 8 * 1];
-			}
-
-			tileId = cube->tileFront;
-			if (tileId != -1)
-			{
-				Gnd::Tile* tile = tiles[tileId];
-				assert(tile && tile->lightmapIndex != -1);
-				Gnd::Lightmap* lightmap = lightmaps[tile->lightmapIndex];
-
-				if (y < width)
-				{
-					auto otherCube = cubes[x][y + 1];
-					if (otherCube->tileFront != -1)
-					{
-						auto otherTile = tiles[otherCube->tileFront];
-						auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-						for (int i = 0; i < 8; i++)
-							lightmap->data[0 + 8 * i] = otherLightmap->data[6 + 8 * i];
-					}
-					else
-						for (int i = 0; i < 8; i++)
-							lightmap->data[0 + 8 * i] = lightmap->data[1 + 8 * i];
-				}
-
-				if (y > 0)
-				{
-					auto otherCube = cubes[x][y - 1];
-					if (otherCube->tileFront != -1)
-					{
-						auto otherTile = tiles[otherCube->tileFront];
-						auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-						for (int i = 0; i < 8; i++)
-							lightmap->data[7 + 8 * i] = otherLightmap->data[1 + 8 * i];
-					}
-					else
-						for (int i = 0; i < 8; i++)
-							lightmap->data[7 + 8 * i] = lightmap->data[6 + 8 * i];
-				}
-
-				if (x < width)
-				{
-					//top and bottom
-					auto otherCube = cubes[x + 1][y];
-					if (otherCube->tileUp != -1)
-					{
-						auto otherTile = tiles[otherCube->tileUp];
-						auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-						for (int i = 0; i < 8; i++)
-							lightmap->data[i + 8 * 7] = otherLightmap->data[i + 8 * 1]; //bottom
-					}
-					else
-						for (int i = 0; i < 8; i++)
-							lightmap->data[i + 8 * 7] = lightmap->data[i + 8 * 6];
-				}
-
-				auto otherCube = cubes[x][y];
-				if (otherCube->tileUp != -1)
-				{
-					auto otherTile = tiles[otherCube->tileUp];
-					auto otherLightmap = lightmaps[otherTile->lightmapIndex];
-
-					for (int i = 0; i < 8; i++)
-						lightmap->data[i + 8 * 0] = otherLightmap->data[i + 8 * 1]; //bottom
-				}
-				else
-					for (int i = 0; i < 8; i++)
-						lightmap->data[i + 8 * 0] = lightmap->data[i + 8 * 1];
-			}
-
-		}
-	}
-
-
-}
-
-
-void Gnd::makeLightmapBorders(int x, int y)
-{
-	if (x < 0 || x >= width || y < 0 || y >= height)
-		return;
-	Gnd::Cube* cube = cubes[x][y];
-	int tileId = cube->tileUp;
-	if (tileId == -1)
-		return;
-	Gnd::Tile* tile = tiles[tileId];
-	assert(tile && tile->lightmapIndex != -1);
-	Gnd::Lightmap* lightmap = lightmaps[tile->lightmapIndex];
-
-	for (int i = 0; i < 8; i++)
-	{
-		lightmap->data[i + 8 * 0] = getLightmapBrightness(x, y - 1, i, 6);
-		lightmap->data[i + 8 * 7] = getLightmapBrightness(x, y + 1, i, 1);
-		lightmap->data[0 + 8 * i] = getLightmapBrightness(x - 1, y, 6, i);
-		lightmap->data[7 + 8 * i] = getLightmapBrightness(x + 1, y, 1, i);
-
-		for (int c = 0; c < 3; c++)
-		{
-			lightmap->data[64 + 3 * (i + 8 * 0) + c] = getLightmapColor(x, y - 1, i, 6)[c];
-			lightmap->data[64 + 3 * (i + 8 * 7) + c] = getLightmapColor(x, y + 1, i, 1)[c];
-			lightmap->data[64 + 3 * (0 + 8 * i) + c] = getLightmapColor(x - 1, y, 6, i)[c];
-			lightmap->data[64 + 3 * (7 + 8 * i) + c] = getLightmapColor(x + 1, y, 1, i)[c];
-
-		}
-	}
-}
-
-
-int Gnd::getLightmapBrightness(int x, int y, int lightmapX, int lightmapY)
-{
-	if (x < 0 || y < 0 || x >= width || y >= height)
-		return 0;
-
-	Gnd::Cube* cube = cubes[x][y];
-	int tileId = cube->tileUp;
-	if (tileId == -1)
-		return 0;
-	Gnd::Tile* tile = tiles[tileId];
-	assert(tile && tile->lightmapIndex != -1);
-	Gnd::Lightmap* lightmap = lightmaps[tile->lightmapIndex];
-
-	return lightmap->data[lightmapX + 8 * lightmapY];
-
-}
-
-glm::ivec3 Gnd::getLightmapColor(int x, int y, int lightmapX, int lightmapY)
-{
-	if (x < 0 || y < 0 || x >= width || y >= height)
-		return glm::ivec3(0, 0, 0);
-
-	Gnd::Cube* cube = cubes[x][y];
-	int tileId = cube->tileUp;
-	if (tileId == -1)
-		return glm::ivec3(0,0,0);
-	Gnd::Tile* tile = tiles[tileId];
-	assert(tile && tile->lightmapIndex != -1);
-	Gnd::Lightmap* lightmap = lightmaps[tile->lightmapIndex];
-
-	return glm::ivec3(
-		lightmap->data[64 + (lightmapX + 8 * lightmapY) * 3 + 0],
-		lightmap->data[64 + (lightmapX + 8 * lightmapY) * 3 + 1],
-		lightmap->data[64 + (lightmapX + 8 * lightmapY) * 3 + 2]);
-
-
-}
-
-void Gnd::makeLightmapsSmooth()
-{
-	Log::out << "Smoothing..." << Log::newline;
-	for (int x = 0; x < width; x++)
-	{
-		for (int y = 0; y < height; y++)
-		{
-			Gnd::Cube* cube = cubes[x][y];
-			int tileId = cube->tileUp;
-			if (tileId == -1)
-				continue;
-			Gnd::Tile* tile = tiles[tileId];
-			assert(tile && tile->lightmapIndex != -1);
-			Gnd::Lightmap* lightmap = lightmaps[tile->lightmapIndex];
-
-			char newData[64];
-
-			for (int xx = 1; xx < 7; xx++)
-			{
-				for (int yy = 1; yy < 7; yy++)
-				{
-					int total = 0;
-					for (int xxx = xx - 1; xxx <= xx + 1; xxx++)
-						for (int yyy = yy - 1; yyy <= yy + 1; yyy++)
-							total += lightmap->data[xxx + 8 * yyy];
-					newData[xx + 8 * yy] = total / 9;
-				}
-			}
-			memcpy(lightmap->data, newData, 64 * sizeof(char));
-		}
-	}
-
-}
+#include "Gnd.h"
+#include "BufferReader.h"
+#include "BufferWriter.h"
+
+#include <set>
+#include <unordered_map>
+#include <cstdint>
+
+#include <blib/util/FileSystem.h>
+#include <blib/util/Log.h>
+#include <blib/linq.h>
+#include <blib/Texture.h>
+#include <blib/ResourceManager.h>
+using blib::util::Log;
+
+Gnd::Gnd(int width, int height)
+{
+	tileLookupCount = 0;
+	sweptTileCount = 0;
+	version = 0x0107;
+	this->width = width;
+	this->height = height;
+	tileScale = 10.0f;
+	maxTexName = 80;
+	lightmapWidth = 8;
+	lightmapHeight = 8;
+	gridSizeCell = 1;
+
+
+	cubeHeights.resize(4 * width * height, 0.0f);
+	cubeTileIds.resize(3 * width * height, -1);
+	cubeNormals.resize(width * height, glm::vec3(0, -1, 0));
+	cubeCornerNormals.resize(4 * width * height, glm::vec3(0, -1, 0));
+	cubeSelection.resize(width * height, false);
+}
+
+
+
+Gnd::Gnd( const std::string &fileName )
+{
+	tileLookupCount = 0;
+	sweptTileCount = 0;
+	blib::util::StreamInFile* file = blib::util::FileSystem::openRead(fileName + ".gnd");
+	if(!file || !file->opened())
+	{
+		width = 0;
+		height = 0;
+		Log::err<<"GND: Unable to open gnd file: "<<fileName<<".gnd"<<Log::newline;
+		return;
+	}
+	Log::out<<"GND: Reading gnd file"<<Log::newline;
+
+	//the whole file is read at once, and the lightmaps, tiles and cubes are decoded straight from the buffer
+	std::vector<char> buffer;
+	BufferReader::readAll(file, buffer);
+	delete file;
+	BufferReader reader(buffer);
+
+	char header[4];
+	reader.read(header, 4);
+	if(header[0] == 'G' && header[1] == 'R' && header[2] == 'G' && header[3] == 'N')
+		version = reader.readShort();
+	else
+	{
+		version = 0;
+		Log::out << "GND: Invalid GND file" << Log::newline;
+	}
+
+	int textureCount = 0;
+
+	if(version > 0)
+	{
+		width = reader.readInt();
+		height = reader.readInt();
+		tileScale = reader.readFloat();
+		textureCount = reader.readInt();
+		maxTexName = reader.readInt();// 80
+	}
+	else
+	{
+		reader.skip(6);//TODO: test this
+		width = reader.readInt();
+		height = reader.readInt();
+		textureCount = reader.readInt();
+	}
+
+	//the counts come from the file, so they are checked against what is left of it before anything is allocated for them.
+	//Every cube takes at least 22 bytes, and every texture 80
+	size_t cubeSize = version >= 0x0106 ? 28 : 22;
+	if (width < 0 || height < 0 || textureCount < 0 || (uint64_t)textureCount * 80 > reader.remaining() ||
+		(uint64_t)width * (uint64_t)height > reader.remaining() / cubeSize)
+	{
+		Log::err << "GND: Invalid size " << width << "x" << height << " or texture count " << textureCount << " in " << fileName << ".gnd" << Log::newline;
+		width = 0;
+		height = 0;
+		return;
+	}
+
+	textures.reserve(textureCount);
+	for(int i = 0; i < textureCount; i++)
+	{
+		Texture* texture = new Texture();
+		texture->file = reader.readString(40);
+		texture->name = reader.readString(40);
+
+		//texture->texture = new Texture("data/texture/" + texture->file); //TODO: blib loader
+
+		textures.push_back(texture);
+	}
+
+
+	if(version > 0)
+	{
+		int lightmapCount = reader.readInt();
+		lightmapWidth = reader.readInt();
+		lightmapHeight = reader.readInt();
+		gridSizeCell = reader.readInt();
+
+		//Fix lightmap format if it was invalid. by Henko
+		if (lightmapWidth != 8 || lightmapHeight != 8 || gridSizeCell != 1)
+		{
+			Log::err<<"GND: Invalid Lightmap Format in "<<fileName<<".gnd"<<Log::newline;
+			lightmapWidth = 8;
+			lightmapHeight = 8;
+			gridSizeCell = 1;
+		}
+
+		if (lightmapCount < 0 || (size_t)lightmapCount > reader.remaining() / 256)
+		{
+			Log::err << "GND: Lightmaps are truncated in " << fileName << ".gnd" << Log::newline;
+			lightmapCount = (int)(reader.remaining() / 256);
+		}
+		lightmaps.resize(lightmapCount);
+		if (lightmapCount > 0)
+			memcpy(lightmaps.data(), reader.current(), lightmapCount * 256);
+		reader.skip(lightmapCount * 256);
+
+		//tiles are 40 byte records: 8 floats for the texture coordinates, texture index, lightmap index and a bgra color
+		int tileCount = reader.readInt();
+		Log::out << "Tilecount: " << tileCount << Log::newline;
+		if (tileCount < 0 || (size_t)tileCount > reader.remaining() / 40)
+		{
+			Log::err << "GND: Tiles are truncated in " << fileName << ".gnd" << Log::newline;
+			tileCount = (int)(reader.remaining() / 40);
+		}
+		tiles.resize(tileCount);
+		const char* p = reader.current();
+		for(int i = 0; i < tileCount; i++, p += 40)
+		{
+			Tile &tile = tiles[i];
+
+			float uv[8];
+			short textureIndex;
+			unsigned short lightmapIndex;
+			memcpy(uv, p, sizeof(uv));
+			memcpy(&textureIndex, p + 32, 2);
+			memcpy(&lightmapIndex, p + 34, 2);
+
+			tile.v1.x = uv[0];
+			tile.v2.x = uv[1];
+			tile.v3.x = uv[2];
+			tile.v4.x = uv[3];
+			tile.v1.y = uv[4];
+			tile.v2.y = uv[5];
+			tile.v3.y = uv[6];
+			tile.v4.y = uv[7];
+			tile.textureIndex = textureIndex;
+			tile.lightmapIndex = lightmapIndex;
+
+			if (tile.lightmapIndex < 0 || tile.lightmapIndex == (unsigned short)-1)
+			{
+				Log::out << "Lightmapindex < 0" << Log::newline;
+				tile.lightmapIndex = 0;
+			}
+
+			tile.color.b = (unsigned char)p[36];
+			tile.color.g = (unsigned char)p[37];
+			tile.color.r = (unsigned char)p[38];
+			tile.color.a = (unsigned char)p[39];
+		}
+		reader.skip(tileCount * 40);
+
+
+
+		//cubes are 4 heights, followed by 3 tile ids that are ints since 0x0106, and unsigned words before that
+		//they are stored in the same row-major order as the file, so they can be copied over record by record
+		int cubeCount = width * height;
+		if ((size_t)cubeCount > reader.remaining() / cubeSize)
+		{
+			Log::err << "GND: Cubes are truncated in " << fileName << ".gnd" << Log::newline;
+			cubeCount = (int)(reader.remaining() / cubeSize);
+		}
+		cubeHeights.resize(4 * width * height, 0.0f);
+		cubeTileIds.resize(3 * width * height, -1);
+		cubeNormals.resize(width * height);
+		cubeCornerNormals.resize(4 * width * height);
+		cubeSelection.resize(width * height, false);
+
+		p = reader.current();
+		if (version >= 0x0106)
+		{
+			for (int i = 0; i < cubeCount; i++, p += cubeSize)
+			{
+				memcpy(&cubeHeights[4 * i], p, 16);
+				memcpy(&cubeTileIds[3 * i], p + 16, 12);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < cubeCount; i++, p += cubeSize)
+			{
+				unsigned short tileIds[3];
+				memcpy(&cubeHeights[4 * i], p, 16);
+				memcpy(tileIds, p + 16, 6);
+				cubeTileIds[3 * i + 0] = tileIds[0];
+				cubeTileIds[3 * i + 1] = tileIds[1];
+				cubeTileIds[3 * i + 2] = tileIds[2];
+			}
+		}
+		reader.skip(cubeCount * cubeSize);
+
+		static const char* tileNames[3] = { "tileup", "tileside", "tilefront" };
+		for (int i = 0; i < 3 * width * height; i++)
+		{
+			if (cubeTileIds[i] >= (int)tiles.size())
+			{
+				Log::out << "Wrong value for " << tileNames[i % 3] << " at " << (i / 3) % width << ", " << (i / 3) / width << Log::newline;
+				cubeTileIds[i] = -1;
+			}
+		}
+	}
+	else
+	{
+		//TODO: port code...too lazy for now
+	}
+	Log::out<<"GND: Done reading gnd file"<<Log::newline;
+	sweptTileCount = tiles.size();
+
+	calcNormals();
+	Log::out<<"GND: Done calculating normals" << Log::newline;
+}
+
+Gnd::~Gnd()
+{
+	blib::linq::deleteall(textures);
+}
+
+
+
+
+//copies everything but the gpu textures, which are loaded again by the renderer when needed
+Gnd::Gnd(const Gnd &other) : version(other.version), width(other.width), height(other.height), tileScale(other.tileScale), maxTexName(other.maxTexName),
+	lightmapWidth(other.lightmapWidth), lightmapHeight(other.lightmapHeight), gridSizeCell(other.gridSizeCell),
+	lightmaps(other.lightmaps), tiles(other.tiles), tileLookupCount(0), sweptTileCount(other.sweptTileCount),
+	cubeHeights(other.cubeHeights), cubeTileIds(other.cubeTileIds), cubeNormals(other.cubeNormals), cubeCornerNormals(other.cubeCornerNormals),
+	cubeSelection(other.cubeSelection)
+{
+	textures.reserve(other.textures.size());
+	for (const Texture* t : other.textures)
+	{
+		Texture* texture = new Texture();
+		texture->name = t->name;
+		texture->file = t->file;
+		textures.push_back(texture);
+	}
+}
+
+void Gnd::save(std::string fileName)
+{
+	BufferWriter writer;
+	save(writer);
+	writer.save(fileName + ".gnd");
+}
+
+void Gnd::save(BufferWriter &writer) const
+{
+	char header[5] = "GRGN";
+	writer.write(header, 4);
+	writer.writeShort(version);
+
+	if (version > 0)
+	{
+		writer.writeInt(width);
+		writer.writeInt(height);
+		writer.writeFloat(tileScale);
+		writer.writeInt(textures.size());
+		writer.writeInt(maxTexName);// iunno
+	}
+	
+	
+	for (size_t i = 0; i < textures.size(); i++)
+	{
+		writer.writeString(textures[i]->file, 40);
+		writer.writeString(textures[i]->name, 40);
+	}
+
+
+	if (version > 0)
+	{
+		writer.writeInt(lightmaps.size());
+		writer.writeInt(lightmapWidth);
+		writer.writeInt(lightmapHeight);
+		writer.writeInt(gridSizeCell);
+
+		if (!lightmaps.empty())
+			writer.write((char*)lightmaps.data(), lightmaps.size() * sizeof(Lightmap));
+
+		writer.writeInt(tiles.size());
+		for (size_t i = 0; i < tiles.size(); i++)
+		{
+			const Tile &tile = tiles[i];
+
+			writer.writeFloat(tile.v1.x);
+			writer.writeFloat(tile.v2.x);
+			writer.writeFloat(tile.v3.x);
+			writer.writeFloat(tile.v4.x);
+			writer.writeFloat(tile.v1.y);
+			writer.writeFloat(tile.v2.y);
+			writer.writeFloat(tile.v3.y);
+			writer.writeFloat(tile.v4.y);
+			writer.writeUWord(tile.textureIndex);
+			writer.writeUWord(tile.lightmapIndex);
+	
+			writer.put(tile.color.b);
+			writer.put(tile.color.g);
+			writer.put(tile.color.r);
+			writer.put(tile.color.a);
+		}
+
+		for (int i = 0; i < width * height; i++)
+		{
+			writer.writeFloat(cubeHeights[4 * i + 0]);
+			writer.writeFloat(cubeHeights[4 * i + 1]);
+			writer.writeFloat(cubeHeights[4 * i + 2]);
+			writer.writeFloat(cubeHeights[4 * i + 3]);
+			if (version >= 0x0106)
+			{
+				writer.writeInt(cubeTileIds[3 * i + 0]);
+				writer.writeInt(cubeTileIds[3 * i + 1]);
+				writer.writeInt(cubeTileIds[3 * i + 2]);
+			}
+			else
+			{
+				writer.writeUWord(cubeTileIds[3 * i + 0]);
+				writer.writeUWord(cubeTileIds[3 * i + 1]);
+				writer.writeUWord(cubeTileIds[3 * i + 2]);
+			}
+		}
+
+
+	}
+
+}
+
+
+Gnd::Texture::Texture()
+{
+	texture = NULL;
+}
+
+Gnd::Texture::~Texture()
+{
+	if(texture)
+		blib::ResourceManager::getInstance().dispose(texture);
+	texture = NULL;
+}
+
+void Gnd::calcNormal(int x, int y)
+{
+/*
+	1----2
+	|\   |
+	| \  |
+	|  \ |
+	|   \|
+	3----4
+*/
+	int index = cubeIndex(x, y);
+	const float* h = &cubeHeights[4 * index];
+	glm::vec3 v1(10, -h[0], 0);
+	glm::vec3 v2(0, -h[1], 0);
+	glm::vec3 v3(10, -h[2], 10);
+	glm::vec3 v4(0, -h[3], 10);
+
+	glm::vec3 normal1 = glm::normalize(glm::cross(v4 - v3, v1 - v3));
+	glm::vec3 normal2 = glm::normalize(glm::cross(v1 - v2, v4 - v2));
+	cubeNormals[index] = glm::normalize(normal1 + normal2);
+	for (int i = 0; i < 4; i++)
+		cubeCornerNormals[4 * index + i] = cubeNormals[index];
+}
+
+
+//recalculates the face normals of the cubes in x1-x2, y1-y2, and the smoothed corner normals of those cubes and the cubes
+//around them, as those share corners with the changed cubes. The corner normal is the average of the face normals of the
+//4 cubes around the corner, so it is calculated once per corner point instead of once for each of the 4 cubes using it.
+//Cubes on the edge of the map keep their face normal on all corners
+void Gnd::calcNormals(int x1, int y1, int x2, int y2)
+{
+	x1 = glm::max(x1, 0);
+	y1 = glm::max(y1, 0);
+	x2 = glm::min(x2, width - 1);
+	y2 = glm::min(y2, height - 1);
+	if (x1 > x2 || y1 > y2)
+		return;
+	for (int y = y1; y <= y2; y++)
+		for (int x = x1; x <= x2; x++)
+			calcNormal(x, y);
+
+	int cx1 = glm::max(x1 - 1, 1);
+	int cy1 = glm::max(y1 - 1, 1);
+	int cx2 = glm::min(x2 + 1, width - 2);
+	int cy2 = glm::min(y2 + 1, height - 2);
+	if (cx1 > cx2 || cy1 > cy2)
+		return;
+	int pointsWidth = cx2 - cx1 + 2;
+	std::vector<glm::vec3> pointNormals(pointsWidth * (cy2 - cy1 + 2));
+	for (int y = cy1; y <= cy2 + 1; y++)
+	{
+		const glm::vec3* above = &cubeNormals[cubeIndex(cx1 - 1, y - 1)];
+		const glm::vec3* below = &cubeNormals[cubeIndex(cx1 - 1, y)];
+		glm::vec3* points = &pointNormals[pointsWidth * (y - cy1)];
+		for (int x = 0; x < pointsWidth; x++)
+			points[x] = glm::normalize(above[x] + above[x + 1] + below[x] + below[x + 1]);
+	}
+	for (int y = cy1; y <= cy2; y++)
+	{
+		const glm::vec3* points = &pointNormals[pointsWidth * (y - cy1)];
+		glm::vec3* normals = &cubeCornerNormals[4 * cubeIndex(cx1, y)];
+		for (int x = 0; x < cx2 - cx1 + 1; x++)
+		{
+			normals[4 * x + 0] = points[x];
+			normals[4 * x + 1] = points[x + 1];
+			normals[4 * x + 2] = points[x + pointsWidth];
+			normals[4 * x + 3] = points[x + 1 + pointsWidth];
+		}
+	}
+}
+
+void Gnd::calcNormals()
+{
+	calcNormals(0, 0, width - 1, height - 1);
+}
+
+
+//true if no two surfaces share a tile, and no two tiles share a lightmap, so lightmaps can be edited in place
+bool Gnd::lightmapsUnique() const
+{
+	std::vector<bool> taken(tiles.size(), false);
+	for (int tileId : cubeTileIds)
+	{
+		if (tileId < 0 || tileId >= (int)taken.size())
+			continue;
+		if (taken[tileId])
+			return false;
+		taken[tileId] = true;
+	}
+	std::vector<bool> takenLightmaps(lightmaps.size(), false);
+	for (const Tile &t : tiles)
+	{
+		if (t.lightmapIndex < 0 || t.lightmapIndex >= (int)takenLightmaps.size())
+			continue;
+		if (takenLightmaps[t.lightmapIndex])
+			return false;
+		takenLightmaps[t.lightmapIndex] = true;
+	}
+	return true;
+}
+
+//gives every surface its own tile, and every tile its own lightmap, so lightmaps can be calculated and painted per surface.
+//Runs in linear time, so it can be called before every lightmap edit. Returns true if any tile or lightmap was added
+bool Gnd::makeLightmapsUnique()
+{
+	size_t oldTileCount = tiles.size();
+	size_t oldLightmapCount = lightmaps.size();
+	std::vector<bool> taken(tiles.size(), false);
+	for (int &tileId : cubeTileIds)
+	{
+		if (tileId < 0 || tileId >= (int)taken.size())
+			continue;
+		if (!taken[tileId])
+			taken[tileId] = true;
+		else
+		{
+			Tile t = tiles[tileId];
+			tileId = tiles.size();
+			tiles.push_back(t);
+		}
+	}
+	std::vector<bool> takenLightmaps(lightmaps.size(), false);
+	for (Tile &t : tiles)
+	{
+		if (t.lightmapIndex < 0 || t.lightmapIndex >= (int)takenLightmaps.size())
+			continue;
+		if (!takenLightmaps[t.lightmapIndex])
+			takenLightmaps[t.lightmapIndex] = true;
+		else
+		{
+			Lightmap l = lightmaps[t.lightmapIndex];
+			t.lightmapIndex = lightmaps.size();
+			lightmaps.push_back(l);
+		}
+	}
+	return tiles.size() != oldTileCount || lightmaps.size() != oldLightmapCount;
+}
+
+//hash of a block of memory, 8 bytes at a time. Only used to find candidates, equal blocks are compared with memcmp after
+static uint64_t hashBlock(const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	uint64_t hash = 14695981039346656037ULL;
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t word;
+		memcpy(&word, bytes + i, 8);
+		hash = (hash ^ word) * 1099511628211ULL;
+	}
+	for (; i < size; i++)
+		hash = (hash ^ bytes[i]) * 1099511628211ULL;
+	return hash ^ (hash >> 32);
+}
+
+static_assert(sizeof(Gnd::Tile) == 4 * sizeof(glm::vec2) + 2 * sizeof(int) + sizeof(glm::ivec4), "Tiles are compared as raw memory, they can't have padding");
+
+//the inverse of makeLightmapsUnique: lightmaps with the same contents are merged, then the tiles are swept, which merges
+//tiles that only differed in their lightmap too. Returns the number of bytes this saves in the gnd file
+size_t Gnd::compact()
+{
+	size_t oldLightmapCount = lightmaps.size();
+	size_t oldTileCount = tiles.size();
+
+	std::vector<bool> tileUsed(tiles.size(), false);
+	for (int tileId : cubeTileIds)
+		if (tileId >= 0 && tileId < (int)tiles.size())
+			tileUsed[tileId] = true;
+
+	std::vector<bool> lightmapUsed(lightmaps.size(), false);
+	for (size_t i = 0; i < tiles.size(); i++)
+		if (tileUsed[i] && tiles[i].lightmapIndex >= 0 && tiles[i].lightmapIndex < (int)lightmaps.size())
+			lightmapUsed[tiles[i].lightmapIndex] = true;
+
+	std::vector<int> lightmapRemap(lightmaps.size(), 0);
+	std::vector<Lightmap> newLightmaps;
+	std::unordered_multimap<uint64_t, int> lightmapLookup;
+	for (size_t i = 0; i < lightmaps.size(); i++)
+	{
+		if (!lightmapUsed[i])
+			continue;
+		uint64_t hash = hashBlock(lightmaps[i].data, sizeof(Lightmap));
+		int index = -1;
+		auto range = lightmapLookup.equal_range(hash);
+		for (auto it = range.first; it != range.second && index == -1; it++)
+			if (memcmp(newLightmaps[it->second].data, lightmaps[i].data, sizeof(Lightmap)) == 0)
+				index = it->second;
+		if (index == -1)
+		{
+			index = newLightmaps.size();
+			newLightmaps.push_back(lightmaps[i]);
+			lightmapLookup.insert(std::make_pair(hash, index));
+		}
+		lightmapRemap[i] = index;
+	}
+	if (newLightmaps.empty() && !lightmaps.empty()) //keep one, new tiles use lightmap 0
+		newLightmaps.push_back(lightmaps[0]);
+	lightmaps.swap(newLightmaps);
+	for (Tile &tile : tiles)
+		tile.lightmapIndex = (tile.lightmapIndex >= 0 && tile.lightmapIndex < (int)lightmapRemap.size()) ? lightmapRemap[tile.lightmapIndex] : 0;
+
+	sweepTiles();
+
+	size_t saved = (oldLightmapCount - lightmaps.size()) * sizeof(Lightmap) + (oldTileCount - tiles.size()) * 40; //a tile is 40 bytes in the file
+	Log::out << "GND: compacted " << oldLightmapCount << " lightmaps to " << lightmaps.size() << ", " << oldTileCount << " tiles to " << tiles.size() << ", saving " << (saved / 1024) << "kb" << Log::newline;
+	return saved;
+}
+
+int Gnd::addTile(const Tile &tile)
+{
+	auto find = [this](uint64_t hash, const Tile &tile)
+	{
+		auto range = tileLookup.equal_range(hash);
+		for (auto it = range.first; it != range.second; it++) //the tile may have been changed in place since it was added
+			if (it->second < (int)tiles.size() && memcmp(&tiles[it->second], &tile, sizeof(Tile)) == 0)
+				return it->second;
+		return -1;
+	};
+
+	if (tileLookupCount > tiles.size()) //tiles were removed without a sweep
+	{
+		tileLookup.clear();
+		tileLookupCount = 0;
+	}
+	//tiles that were added without addTile, or loaded from the file, are looked up too. Duplicates aren't added, so equal_range stays short
+	for (; tileLookupCount < tiles.size(); tileLookupCount++)
+	{
+		uint64_t hash = hashBlock(&tiles[tileLookupCount], sizeof(Tile));
+		if (find(hash, tiles[tileLookupCount]) == -1)
+			tileLookup.insert(std::make_pair(hash, (int)tileLookupCount));
+	}
+
+	uint64_t hash = hashBlock(&tile, sizeof(Tile));
+	int index = find(hash, tile);
+	if (index != -1)
+		return index;
+	tiles.push_back(tile);
+	tileLookup.insert(std::make_pair(hash, (int)tileLookupCount));
+	tileLookupCount++;
+	return tiles.size() - 1;
+}
+
+int Gnd::sweepTiles()
+{
+	size_t oldTileCount = tiles.size();
+	std::vector<bool> tileUsed(tiles.size(), false);
+	for (int tileId : cubeTileIds)
+		if (tileId >= 0 && tileId < (int)tiles.size())
+			tileUsed[tileId] = true;
+
+	std::vector<int> tileRemap(tiles.size(), -1);
+	std::vector<Tile> newTiles;
+	tileLookup.clear();
+	for (size_t i = 0; i < tiles.size(); i++)
+	{
+		if (!tileUsed[i])
+			continue;
+		uint64_t hash = hashBlock(&tiles[i], sizeof(Tile));
+		int index = -1;
+		auto range = tileLookup.equal_range(hash);
+		for (auto it = range.first; it != range.second && index == -1; it++)
+			if (memcmp(&newTiles[it->second], &tiles[i], sizeof(Tile)) == 0)
+				index = it->second;
+		if (index == -1)
+		{
+			index = newTiles.size();
+			newTiles.push_back(tiles[i]);
+			tileLookup.insert(std::make_pair(hash, index));
+		}
+		tileRemap[i] = index;
+	}
+	tiles.swap(newTiles);
+	for (int &tileId : cubeTileIds)
+		if (tileId >= 0)
+			tileId = tileId < (int)tileRemap.size() ? tileRemap[tileId] : -1;
+	tileLookupCount = tiles.size();
+	sweptTileCount = tiles.size();
+	return (int)(oldTileCount - tiles.size());
+}
+
+void Gnd::makeLightmapBorders()
+{
+	makeLightmapsUnique();
+	Log::out << "Fixing borders" << Log::newline;
+	for (int x = 0; x < width; x++)
+	{
+		for (int y = 0; y < height; y++)
+		{
+			Gnd::Cube c = cube(x, y);
+			int tileId = c.tileUp;
+			if (tileId != -1)
+			{
+				Gnd::Tile &tile = tiles[tileId];
+				assert(tile.lightmapIndex != -1);
+				Gnd::Lightmap &lightmap = lightmaps[tile.lightmapIndex];
+
+				for (int i = 0; i < 8; i++)
+				{
+					lightmap.data[i + 8 * 0] = getLightmapBrightness(x, y - 1, i, 6);
+					lightmap.data[i + 8 * 7] = getLightmapBrightness(x, y + 1, i, 1);
+					lightmap.data[0 + 8 * i] = getLightmapBrightness(x - 1, y, 6, i);
+					lightmap.data[7 + 8 * i] = getLightmapBrightness(x + 1, y, 1, i);
+
+					for (int c = 0; c < 3; c++)
+					{
+						lightmap.data[64 + 3 * (i + 8 * 0) + c] = getLightmapColor(x, y - 1, i, 6)[c];
+						lightmap.data[64 + 3 * (i + 8 * 7) + c] = getLightmapColor(x, y + 1, i, 1)[c];
+						lightmap.data[64 + 3 * (0 + 8 * i) + c] = getLightmapColor(x - 1, y, 6, i)[c];
+						lightmap.data[64 + 3 * (7 + 8 * i) + c] = getLightmapColor(x + 1, y, 1, i)[c];
+
+					}
+
+				}
+			}
+			tileId = c.tileSide;
+			if (tileId != -1)
+			{
+				Gnd::Tile &tile = tiles[tileId];
+				assert(tile.lightmapIndex != -1);
+				Gnd::Lightmap &lightmap = lightmaps[tile.lightmapIndex];
+
+				Gnd::Cube left = cube(x-1, y);
+				if (left.tileSide != -1)
+				{
+					auto &otherTile = tiles[left.tileSide];
+					auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+					for (int i = 0; i < 8; i++)
+						lightmap.data[0 + 8 * i] = otherLightmap.data[6 + 8 * i];
+				}
+				else
+					for (int i = 0; i < 8; i++)
+						lightmap.data[0 + 8 * i] = lightmap.data[1 + 8 * i];
+
+				Gnd::Cube right = cube(x+1, y);
+				if (right.tileSide != -1)
+				{
+					auto &otherTile = tiles[right.tileSide];
+					auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+					for (int i = 0; i < 8; i++)
+						lightmap.data[7 + 8 * i] = otherLightmap.data[1 + 8 * i];
+				}
+				else
+					for (int i = 0; i < 8; i++)
+						lightmap.data[7 + 8 * i] = lightmap.data[6 + 8 * i];
+
+				//top and bottom
+				Gnd::Cube bottom = cube(x, y+1);
+				if (bottom.tileUp != -1)
+				{
+					auto &otherTile = tiles[bottom.tileUp];
+					auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+					for (int i = 0; i < 8; i++)
+						lightmap.data[i + 8 * 7] = otherLightmap.data[i + 8 * 1]; //bottom
+				}
+				else
+					for (int i = 0; i < 8; i++)
+						lightmap.data[i + 8 * 7] = lightmap.data[i + 8 * 6];
+
+
+				Gnd::Cube top = cube(x, y);
+				if (top.tileUp != -1)
+				{
+					auto &otherTile = tiles[top.tileUp];
+					auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+					for (int i = 0; i < 8; i++)
+						lightmap.data[i + 8 * 0] = otherLightmap.data[i + 8 * 1]; //bottom
+				}
+				else
+					for (int i = 0; i < 8; i++)
+						lightmap.data[i + 8 * 0] = lightmap.data[i + 8 * 1];
+			}
+
+			tileId = c.tileFront;
+			if (tileId != -1)
+			{
+				Gnd::Tile &tile = tiles[tileId];
+				assert(tile.lightmapIndex != -1);
+				Gnd::Lightmap &lightmap = lightmaps[tile.lightmapIndex];
+
+				if (y < width)
+				{
+					auto otherCube = cube(x, y + 1);
+					if (otherCube.tileFront != -1)
+					{
+						auto &otherTile = tiles[otherCube.tileFront];
+						auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+						for (int i = 0; i < 8; i++)
+							lightmap.data[0 + 8 * i] = otherLightmap.data[6 + 8 * i];
+					}
+					else
+						for (int i = 0; i < 8; i++)
+							lightmap.data[0 + 8 * i] = lightmap.data[1 + 8 * i];
+				}
+
+				if (y > 0)
+				{
+					auto otherCube = cube(x, y - 1);
+					if (otherCube.tileFront != -1)
+					{
+						auto &otherTile = tiles[otherCube.tileFront];
+						auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+						for (int i = 0; i < 8; i++)
+							lightmap.data[7 + 8 * i] = otherLightmap.data[1 + 8 * i];
+					}
+					else
+						for (int i = 0; i < 8; i++)
+							lightmap.data[7 + 8 * i] = lightmap.data[6 + 8 * i];
+				}
+
+				if (x < width)
+				{
+					//top and bottom
+					auto otherCube = cube(x + 1, y);
+					if (otherCube.tileUp != -1)
+					{
+						auto &otherTile = tiles[otherCube.tileUp];
+						auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+						for (int i = 0; i < 8; i++)
+							lightmap.data[i + 8 * 7] = otherLightmap.data[i + 8 * 1]; //bottom
+					}
+					else
+						for (int i = 0; i < 8; i++)
+							lightmap.data[i + 8 * 7] = lightmap.data[i + 8 * 6];
+				}
+
+				auto otherCube = cube(x, y);
+				if (otherCube.tileUp != -1)
+				{
+					auto &otherTile = tiles[otherCube.tileUp];
+					auto &otherLightmap = lightmaps[otherTile.lightmapIndex];
+
+					for (int i = 0; i < 8; i++)
+						lightmap.data[i + 8 * 0] = otherLightmap.data[i + 8 * 1]; //bottom
+				}
+				else
+					for (int i = 0; i < 8; i++)
+						lightmap.data[i + 8 * 0] = lightmap.data[i + 8 * 1];
+			}
+
+		}
+	}
+
+
+}
+
+
+void Gnd::makeLightmapBorders(int x, int y)
+{
+	if (x < 0 || x >= width || y < 0 || y >= height)
+		return;
+	Gnd::Cube c = cube(x, y);
+	int tileId = c.tileUp;
+	if (tileId == -1)
+		return;
+	Gnd::Tile &tile = tiles[tileId];
+	assert(tile.lightmapIndex != -1);
+	Gnd::Lightmap &lightmap = lightmaps[tile.lightmapIndex];
+
+	for (int i = 0; i < 8; i++)
+	{
+		lightmap.data[i + 8 * 0] = getLightmapBrightness(x, y - 1, i, 6);
+		lightmap.data[i + 8 * 7] = getLightmapBrightness(x, y + 1, i, 1);
+		lightmap.data[0 + 8 * i] = getLightmapBrightness(x - 1, y, 6, i);
+		lightmap.data[7 + 8 * i] = getLightmapBrightness(x + 1, y, 1, i);
+
+		for (int c = 0; c < 3; c++)
+		{
+			lightmap.data[64 + 3 * (i + 8 * 0) + c] = getLightmapColor(x, y - 1, i, 6)[c];
+			lightmap.data[64 + 3 * (i + 8 * 7) + c] = getLightmapColor(x, y + 1, i, 1)[c];
+			lightmap.data[64 + 3 * (0 + 8 * i) + c] = getLightmapColor(x - 1, y, 6, i)[c];
+			lightmap.data[64 + 3 * (7 + 8 * i) + c] = getLightmapColor(x + 1, y, 1, i)[c];
+
+		}
+	}
+}
+
+
+int Gnd::getLightmapBrightness(int x, int y, int lightmapX, int lightmapY)
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return 0;
+
+	Gnd::Cube c = cube(x, y);
+	int tileId = c.tileUp;
+	if (tileId == -1)
+		return 0;
+	Gnd::Tile &tile = tiles[tileId];
+	assert(tile.lightmapIndex != -1);
+	Gnd::Lightmap &lightmap = lightmaps[tile.lightmapIndex];
+
+	return lightmap.data[lightmapX + 8 * lightmapY];
+
+}
+
+glm::ivec3 Gnd::getLightmapColor(int x, int y, int lightmapX, int lightmapY)
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return glm::ivec3(0, 0, 0);
+
+	Gnd::Cube c = cube(x, y);
+	int tileId = c.tileUp;
+	if (tileId == -1)
+		return glm::ivec3(0,0,0);
+	Gnd::Tile &tile = tiles[tileId];
+	assert(tile.lightmapIndex != -1);
+	Gnd::Lightmap &lightmap = lightmaps[tile.lightmapIndex];
+
+	return glm::ivec3(
+		lightmap.data[64 + (lightmapX + 8 * lightmapY) * 3 + 0],
+		lightmap.data[64 + (lightmapX + 8 * lightmapY) * 3 + 1],
+		lightmap.data[64 + (lightmapX + 8 * lightmapY) * 3 + 2]);
+
+
+}
+
+void Gnd::makeLightmapsSmooth()
+{
+	Log::out << "Smoothing..." << Log::newline;
+	for (int x = 0; x < width; x++)
+	{
+		for (int y = 0; y < height; y++)
+		{
+			Gnd::Cube c = cube(x, y);
+			int tileId = c.tileUp;
+			if (tileId == -1)
+				continue;
+			Gnd::Tile &tile = tiles[tileId];
+			assert(tile.lightmapIndex != -1);
+			Gnd::Lightmap &lightmap = lightmaps[tile.lightmapIndex];
+
+			char newData[64];
+
+			for (int xx = 1; xx < 7; xx++)
+			{
+				for (int yy = 1; yy < 7; yy++)
+				{
+					int total = 0;
+					for (int xxx = xx - 1; xxx <= xx + 1; xxx++)
+						for (int yyy = yy - 1; yyy <= yy + 1; yyy++)
+							total += lightmap.data[xxx + 8 * yyy];
+					newData[xx + 8 * yy] = total / 9;
+				}
+			}
+			memcpy(lightmap.data, newData, 64 * sizeof(char));
+		}
+	}
+
+}
@@ -1,112 +1,139 @@
-#pragma once
-
-#include <string>
-#include <vector>
-#include <glm/glm.hpp>
-
-namespace blib { class Texture; }
-
-class Gnd
-{
-public:
-	Gnd(const std::string &fileName);
-	Gnd(int width, int height);
-	~Gnd();
-
-	void save(std::string fileName);
-
-	class Texture
-	{
-	public:
-		std::string name;
-		std::string file;
-
-		blib::Texture* texture;
-		Texture();
-		~Texture();
-	};
-
-	class Lightmap
-	{
-	public:
-		Lightmap() { memset(data, 0, 256 * sizeof(unsigned char)); };
-		Lightmap(const Lightmap& other)
-		{
-			memcpy(data, other.data, 256 * sizeof(unsigned char));
-		}
-		unsigned char data[256];
-	};
-
-	class Tile
-	{
-	public:
-		Tile() {};
-		Tile(const Tile& o) {
-			v1 = o.v1;
-			v2 = o.v2;
-			v3 = o.v3;
-			v4 = o.v4;
-			textureIndex = o.textureIndex;
-			lightmapIndex = o.lightmapIndex;
-			color = o.color;
-		}
-		glm::vec2 v1,v2,v3,v4;
-		int textureIndex;
-		int lightmapIndex;
-		glm::ivec4 color;
-	};
-
-	class Cube
-	{
-	public:
-		Cube() 
-		{
-			selected = rand()%100 == 0;
-		}
-		union 
-		{
-			struct
-			{
-				float h1, h2, h3, h4;
-			};
-			float heights[4];
-		};
-		union
-		{
-			struct
-			{
-				int tileUp, tileSide, tileFront;
-			};
-			int tileIds[3];
-		};
-		bool selected;
-
-		glm::vec3 normal;
-		glm::vec3 normals[4];
-
-		void calcNormal();
-		void calcNormals(Gnd* gnd, int x, int y);
-	};
-
-
-	short version;
-	int width;
-	int height;
-	float tileScale;
-	int maxTexName;
-	int lightmapWidth;
-	int lightmapHeight;
-	int gridSizeCell;
-	std::vector<Texture*> textures;
-	std::vector<Lightmap*> lightmaps;
-	std::vector<Tile*> tiles;
-	std::vector<std::vector<Cube*> > cubes;
-
-
-	void makeLightmapsUnique();
-	void makeLightmapBorders();
-	void makeLightmapBorders(int x, int y);
-	int getLightmapBrightness(int x, int y, int lightmapX, int lightmapY);
-	glm::ivec3 getLightmapColor(int x, int y, int lightmapX, int lightmapY);
-	void makeLightmapsSmooth();
-};
\ No newline at end of file
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace blib { class Texture; }
+class BufferWriter;
+
+class Gnd
+{
+public:
+	Gnd(const std::string &fileName);
+	Gnd(int width, int height);
+	Gnd(const Gnd &other);
+	~Gnd();
+
+	void save(std::string fileName);
+	void save(BufferWriter &writer) const;
+
+	class Texture
+	{
+	public:
+		std::string name;
+		std::string file;
+
+		blib::Texture* texture;
+		Texture();
+		~Texture();
+	};
+
+	class Lightmap
+	{
+	public:
+		Lightmap() { memset(data, 0, 256 * sizeof(unsigned char)); };
+		Lightmap(const Lightmap& other)
+		{
+			memcpy(data, other.data, 256 * sizeof(unsigned char));
+		}
+		unsigned char data[256];
+	};
+	static_assert(sizeof(Lightmap) == 256, "Lightmaps need to be packed");
+
+	class Tile
+	{
+	public:
+		Tile() {};
+		Tile(const Tile& o) {
+			v1 = o.v1;
+			v2 = o.v2;
+			v3 = o.v3;
+			v4 = o.v4;
+			textureIndex = o.textureIndex;
+			lightmapIndex = o.lightmapIndex;
+			color = o.color;
+		}
+		glm::vec2 v1,v2,v3,v4;
+		int textureIndex;
+		int lightmapIndex;
+		glm::ivec4 color;
+	};
+
+	//a handle to a single cube. The cube data itself is stored in the flat arrays below, so a handle stays
+	//valid for as long as the gnd is not resized
+	class Cube
+	{
+	public:
+		Cube(Gnd* gnd, int index);
+
+		float* heights;
+		float &h1, &h2, &h3, &h4;
+		int* tileIds;
+		int &tileUp, &tileSide, &tileFront;
+		std::vector<bool>::reference selected;
+
+		glm::vec3 &normal;
+		glm::vec3* normals;
+	};
+
+
+	short version;
+	int width;
+	int height;
+	float tileScale;
+	int maxTexName;
+	int lightmapWidth;
+	int lightmapHeight;
+	int gridSizeCell;
+	std::vector<Texture*> textures;
+	//tiles and lightmaps are stored by value and referenced by index. The lightmaps are packed back to back,
+	//so the whole table can be copied in one go
+	std::vector<Lightmap> lightmaps;
+	std::vector<Tile> tiles;
+	std::unordered_multimap<uint64_t, int> tileLookup;	//tile contents hash to tile index, for addTile. Checked against the tile itself, so stale entries are harmless
+	size_t tileLookupCount;								//the first tileLookupCount tiles are in tileLookup
+	size_t sweptTileCount;								//tile count right after the last sweep
+
+	//the cubes are stored row-major (index x + width * y), one array per field, so full map passes run linearly through memory
+	std::vector<float> cubeHeights;				//h1, h2, h3, h4 per cube
+	std::vector<int> cubeTileIds;				//tileUp, tileSide, tileFront per cube
+	std::vector<glm::vec3> cubeNormals;			//face normal per cube
+	std::vector<glm::vec3> cubeCornerNormals;	//smoothed normal per corner, 4 per cube
+	std::vector<bool> cubeSelection;
+
+	inline int cubeIndex(int x, int y) const { return x + width * y; }
+	inline Cube cube(int x, int y) { return Cube(this, cubeIndex(x, y)); }
+
+	void calcNormal(int x, int y);
+	void calcNormals(int x1, int y1, int x2, int y2);
+	void calcNormals();
+
+
+	bool lightmapsUnique() const;
+	bool makeLightmapsUnique();
+	size_t compact();
+
+	//interns a tile: returns the index of a tile with the same contents, or adds it. Tiles are shared between surfaces,
+	//so a surface is changed by giving it another tile, not by changing its tile in place
+	int addTile(const Tile &tile);
+	//drops the tiles no cube uses, and merges tiles with the same contents. The cube tile ids are remapped, tile ids that
+	//are kept anywhere else become invalid. Returns the number of tiles dropped
+	int sweepTiles();
+	inline bool tilesNeedSweep() const { return tiles.size() > 2 * sweptTileCount + 1024; }
+	void makeLightmapBorders();
+	void makeLightmapBorders(int x, int y);
+	int getLightmapBrightness(int x, int y, int lightmapX, int lightmapY);
+	glm::ivec3 getLightmapColor(int x, int y, int lightmapX, int lightmapY);
+	void makeLightmapsSmooth();
+};
+
+inline Gnd::Cube::Cube(Gnd* gnd, int index) :
+	heights(&gnd->cubeHeights[4 * index]), h1(heights[0]), h2(heights[1]), h3(heights[2]), h4(heights[3]),
+	tileIds(&gnd->cubeTileIds[3 * index]), tileUp(tileIds[0]), tileSide(tileIds[1]), tileFront(tileIds[2]),
+	selected(gnd->cubeSelection[index]),
+	normal(gnd->cubeNormals[index]), normals(&gnd->cubeCornerNormals[4 * index])
+{
+}
@@ -1,78 +1,758 @@
-#include "GrfFileSystemHandler.h"
-#include <blib/util/Log.h>
-using blib::util::Log;
-
-#include <algorithm>
-#include <cctype>
-
-
-std::string GrfFileSystemHandler::sanitizeFileName(std::string fileName)
-{
-	std::transform(fileName.begin(), fileName.end(), fileName.begin(), ::tolower);
-	std::replace(fileName.begin(), fileName.end(), '/', '\\');
-
-	int index;
-	while((index = fileName.find("\\\\")) != -1)
-		fileName = fileName.substr(0, index) + fileName.substr(index + 1);
-	return fileName;
-}
-
-
-GrfFileSystemHandler::GrfFileSystemHandler( const std::string &grfFile ) : blib::util::FileSystemHandler("Grf")
-{
-	grf = NULL;
-
-	GrfError error;
-	grf = grf_open(grfFile.c_str(), "rb", &error);
-	if (grf == NULL)
-	{
-		Log::err<<"Error opening GRF file: "<<grfFile<<Log::newline;
-		return;
-	}
-	Log::out<<"Loaded GRF file "<<grfFile<<Log::newline;
-	for(unsigned int i = 0; i < grf->nfiles; i++)
-		lookup[sanitizeFileName(grf->files[i].name)] = i;
-	Log::out << lookup.size() << " files loaded"<< Log::newline;
-}
-
-GrfFileSystemHandler::~GrfFileSystemHandler()
-{
-	grf_close(grf);
-}
-
-
-blib::util::StreamInFile* GrfFileSystemHandler::openRead( const std::string &fileName )
-{
-	if(!grf)
-		return NULL;
-	auto it = lookup.find(sanitizeFileName(fileName));
-	if(it == lookup.end())
-		return NULL;
-
-	GrfError error;
-	unsigned int size = 0;
-	char* data = (char*)grf_index_get(grf, it->second, &size, &error);
-
-
-	blib::util::StreamInFile* f = new blib::util::MemoryFile(data, size, true);
-	return f;
-}
-
-void GrfFileSystemHandler::getFileList( const std::string &path, std::vector<std::string> &files )
-{
-	std::string directory = sanitizeFileName(path);
-	for (std::map<std::string, int>::iterator it = lookup.begin(); it != lookup.end(); it++)
-	{
-		if (it->first.substr(0, directory.length()) == directory && it->first.find("\\", directory.size() + 1) == -1)
-			files.push_back(it->first);
-	}
-}
-
-void GrfFileSystemHandler::getFileList(const std::function<bool(const std::string&)> &filter, std::vector<std::string> &files)
-{
-	for (std::map<std::string, int>::iterator it = lookup.begin(); it != lookup.end(); it++)
-	{
-		if (filter(it->first))
-			files.push_back(it->first);
-	}
-}
+#include "GrfFileSystemHandler.h"
+#include <blib/util/Log.h>
+using blib::util::Log;
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+#ifdef WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const char GrfFileSystemHandler::indexMagic[8] = { 'B', 'R', 'O', 'G', 'R', 'F', 'I', 'X' };
+unsigned int GrfFileSystemHandler::streamThreshold = 1024 * 1024;
+unsigned int GrfFileSystemHandler::streamWindow = 16 * 1024;
+
+
+//folds a single character of a filename: lowercase, with / turned into \. Only ascii is folded, so multibyte names are left alone
+static inline char foldChar(char c)
+{
+	if (c >= 'A' && c <= 'Z')
+		return c - 'A' + 'a';
+	if (c == '/')
+		return '\\';
+	return c;
+}
+
+//hashes a filename the same way GRF_NameHash does, but on the folded name, with repeated slashes collapsed
+uint32_t GrfFileSystemHandler::hashFileName(const char* name)
+{
+	uint32_t hash = 0x1505;
+	char prev = 0;
+	for (; *name; name++)
+	{
+		char c = foldChar(*name);
+		if (c == '\\' && prev == '\\')
+			continue;
+		hash = hash * 0x21 + c;
+		prev = c;
+	}
+	return hash;
+}
+
+//compares two filenames as if both were sanitized, without building the sanitized strings
+bool GrfFileSystemHandler::equalFileNames(const char* a, const char* b)
+{
+	while (*a && *b)
+	{
+		char ca = foldChar(*a);
+		char cb = foldChar(*b);
+		if (ca != cb)
+			return false;
+		a++;
+		b++;
+		if (ca == '\\')
+		{
+			while (foldChar(*a) == '\\')
+				a++;
+			while (foldChar(*b) == '\\')
+				b++;
+		}
+	}
+	return *a == *b;
+}
+
+
+std::string GrfFileSystemHandler::sanitizeFileName(const std::string &fileName)
+{
+	std::string ret;
+	ret.reserve(fileName.size());
+	for (char c : fileName)
+	{
+		c = foldChar(c);
+		if (c == '\\' && !ret.empty() && ret.back() == '\\')
+			continue;
+		ret += c;
+	}
+	return ret;
+}
+
+int GrfFileSystemHandler::find(const char* fileName) const
+{
+	if (!table)
+		return -1;
+	uint32_t hash = hashFileName(fileName);
+	for (uint32_t i = hash & tableMask; table[i].index != -1; i = (i + 1) & tableMask)
+		if (table[i].hash == hash && equalFileNames(fileName, grf->files[table[i].index].name))
+			return table[i].index;
+	return -1;
+}
+
+static inline uint32_t align8(uint32_t offset)
+{
+	return (offset + 7) & ~7;
+}
+
+//builds the index block from the file table of the opened grf
+void GrfFileSystemHandler::buildIndex(const std::string &grfFile, uint64_t grfSize, int64_t grfTime)
+{
+	unsigned int tableSize = 16;
+	while (tableSize < grf->nfiles * 2)
+		tableSize *= 2;
+	std::vector<HashSlot> slots(tableSize, HashSlot{ 0, -1 });
+
+	std::vector<std::string> names;
+	names.reserve(grf->nfiles);
+	for (unsigned int i = 0; i < grf->nfiles; i++)
+	{
+		uint32_t hash = hashFileName(grf->files[i].name);
+		uint32_t slot = hash & (tableSize - 1);
+		while (slots[slot].index != -1 && !(slots[slot].hash == hash && equalFileNames(grf->files[i].name, grf->files[slots[slot].index].name)))
+			slot = (slot + 1) & (tableSize - 1);
+		if (slots[slot].index == -1)
+			names.push_back(sanitizeFileName(grf->files[i].name));
+		slots[slot] = HashSlot{ hash, (int)i }; //later entries override earlier ones with the same name
+	}
+	std::sort(names.begin(), names.end());
+
+	IndexHeader header;
+	memset(&header, 0, sizeof(IndexHeader));
+	memcpy(header.magic, indexMagic, sizeof(header.magic));
+	header.version = indexVersion;
+	header.nfiles = grf->nfiles;
+	header.grfSize = grfSize;
+	header.grfTime = grfTime;
+	header.tableSize = tableSize;
+	header.nameCount = (uint32_t)names.size();
+	header.filesOffset = align8(sizeof(IndexHeader));
+	header.tableOffset = align8(header.filesOffset + grf->nfiles * sizeof(IndexFile));
+	header.namesOffset = align8(header.tableOffset + tableSize * sizeof(HashSlot));
+	header.poolOffset = align8(header.namesOffset + header.nameCount * sizeof(uint32_t));
+
+	//string pool: the path of the grf, the original names and the sanitized names
+	std::vector<char> pool(grfFile.c_str(), grfFile.c_str() + grfFile.size() + 1);
+	std::vector<uint32_t> rawNames(grf->nfiles);
+	for (unsigned int i = 0; i < grf->nfiles; i++)
+	{
+		rawNames[i] = (uint32_t)pool.size();
+		pool.insert(pool.end(), grf->files[i].name, grf->files[i].name + strlen(grf->files[i].name) + 1);
+	}
+	std::vector<uint32_t> sortedNames(names.size());
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		sortedNames[i] = (uint32_t)pool.size();
+		pool.insert(pool.end(), names[i].c_str(), names[i].c_str() + names[i].size() + 1);
+	}
+	header.size = header.poolOffset + (uint32_t)pool.size();
+
+	indexData.assign(header.size, 0);
+	memcpy(&indexData[0], &header, sizeof(IndexHeader));
+	IndexFile* files = (IndexFile*)&indexData[header.filesOffset];
+	for (unsigned int i = 0; i < grf->nfiles; i++)
+	{
+		files[i].compressedLen = grf->files[i].compressed_len;
+		files[i].compressedLenAligned = grf->files[i].compressed_len_aligned;
+		files[i].realLen = grf->files[i].real_len;
+		files[i].pos = grf->files[i].pos;
+		files[i].hash = grf->files[i].hash;
+		files[i].name = rawNames[i];
+		files[i].flags = grf->files[i].flags;
+	}
+	memcpy(&indexData[header.tableOffset], &slots[0], tableSize * sizeof(HashSlot));
+	if (!sortedNames.empty())
+		memcpy(&indexData[header.namesOffset], &sortedNames[0], sortedNames.size() * sizeof(uint32_t));
+	memcpy(&indexData[header.poolOffset], &pool[0], pool.size());
+
+	setIndex(&indexData[0]);
+}
+
+void GrfFileSystemHandler::setIndex(const char* data)
+{
+	index = (const IndexHeader*)data;
+	table = (const HashSlot*)(data + index->tableOffset);
+	tableMask = index->tableSize - 1;
+	fileNames = (const uint32_t*)(data + index->namesOffset);
+	namePool = data + index->poolOffset;
+}
+
+//maps the index cache of a grf, and opens the grf with the file table from the cache. Fails if the cache is missing or outdated
+bool GrfFileSystemHandler::loadIndexCache(const std::string &cacheFile, const std::string &grfFile, uint64_t grfSize, int64_t grfTime)
+{
+	size_t size = 0;
+#ifdef WIN32
+	HANDLE file = CreateFileA(cacheFile.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	size = GetFileSize(file, NULL);
+	HANDLE mapping = size >= sizeof(IndexHeader) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+	indexMapHandle = mapping;
+#else
+	int file = open(cacheFile.c_str(), O_RDONLY);
+	if (file == -1)
+		return false;
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size < (off_t)sizeof(IndexHeader))
+	{
+		close(file);
+		return false;
+	}
+	size = info.st_size;
+	void* data = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (data == MAP_FAILED)
+		return false;
+#endif
+	indexMap = data;
+	indexMapSize = size;
+
+	const IndexHeader* header = (const IndexHeader*)data;
+	if (memcmp(header->magic, indexMagic, sizeof(header->magic)) != 0 || header->version != indexVersion ||
+		header->size != size || header->grfSize != grfSize || header->grfTime != grfTime ||
+		header->tableSize == 0 || (header->tableSize & (header->tableSize - 1)) != 0 ||
+		header->filesOffset < sizeof(IndexHeader) ||
+		header->filesOffset + (uint64_t)header->nfiles * sizeof(IndexFile) > header->tableOffset ||
+		header->tableOffset + (uint64_t)header->tableSize * sizeof(HashSlot) > header->namesOffset ||
+		header->namesOffset + (uint64_t)header->nameCount * sizeof(uint32_t) > header->poolOffset ||
+		header->poolOffset >= size || ((const char*)data)[size - 1] != 0 ||
+		grfFile != (const char*)data + header->poolOffset)
+	{
+		unmapIndexCache();
+		return false;
+	}
+
+	//every offset and index in the cache is checked before it is used, so a damaged cache can't read outside of the mapping
+	const IndexFile* files = (const IndexFile*)((const char*)data + header->filesOffset);
+	const HashSlot* slots = (const HashSlot*)((const char*)data + header->tableOffset);
+	const uint32_t* sortedNames = (const uint32_t*)((const char*)data + header->namesOffset);
+	const char* pool = (const char*)data + header->poolOffset;
+	uint64_t poolSize = size - header->poolOffset;
+	bool valid = true;
+	for (unsigned int i = 0; i < header->nfiles && valid; i++)
+		valid = files[i].name < poolSize;
+	for (unsigned int i = 0; i < header->nameCount && valid; i++)
+		valid = sortedNames[i] < poolSize;
+	bool emptySlot = false; //lookups stop at an empty slot, without one they would never end
+	for (unsigned int i = 0; i < header->tableSize && valid; i++)
+	{
+		valid = slots[i].index >= -1 && slots[i].index < (int64_t)header->nfiles;
+		emptySlot |= slots[i].index == -1;
+	}
+	if (!valid || !emptySlot)
+	{
+		unmapIndexCache();
+		return false;
+	}
+
+	GrfError error;
+	grf = grf_open_notable(grfFile.c_str(), &error);
+	if (grf && grf->nfiles != header->nfiles)
+	{
+		grf_close(grf);
+		grf = NULL;
+	}
+	if (!grf)
+	{
+		unmapIndexCache();
+		return false;
+	}
+
+	for (unsigned int i = 0; i < grf->nfiles; i++)
+	{
+		grf->files[i].compressed_len = files[i].compressedLen;
+		grf->files[i].compressed_len_aligned = files[i].compressedLenAligned;
+		grf->files[i].real_len = files[i].realLen;
+		grf->files[i].pos = files[i].pos;
+		grf->files[i].hash = files[i].hash;
+		grf->files[i].flags = files[i].flags;
+		strncpy(grf->files[i].name, pool + files[i].name, GRF_NAMELEN - 1);
+	}
+	setIndex((const char*)data);
+	return true;
+}
+
+void GrfFileSystemHandler::unmapIndexCache()
+{
+	if (!indexMap)
+		return;
+#ifdef WIN32
+	UnmapViewOfFile(indexMap);
+	CloseHandle(indexMapHandle);
+	indexMapHandle = NULL;
+#else
+	munmap(indexMap, indexMapSize);
+#endif
+	indexMap = NULL;
+	indexMapSize = 0;
+}
+
+void GrfFileSystemHandler::saveIndexCache(const std::string &cacheFile)
+{
+	//written to a temporary file first, so a crash halfway doesn't leave a broken cache behind
+	std::string tmpFile = cacheFile + ".tmp";
+	FILE* file = fopen(tmpFile.c_str(), "wb");
+	if (!file)
+	{
+		Log::err << "Unable to write GRF index cache " << cacheFile << Log::newline;
+		return;
+	}
+	bool ok = fwrite(&indexData[0], indexData.size(), 1, file) == 1;
+	ok = fclose(file) == 0 && ok;
+	std::remove(cacheFile.c_str());
+	if (!ok || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+	{
+		std::remove(tmpFile.c_str());
+		Log::err << "Unable to write GRF index cache " << cacheFile << Log::newline;
+	}
+}
+
+
+GrfFileSystemHandler::GrfFileSystemHandler( const std::string &grfFile, size_t cacheBudget, const std::string &indexCacheDirectory ) : blib::util::FileSystemHandler("Grf")
+{
+	grf = NULL;
+	cacheSize = 0;
+	this->cacheBudget = cacheBudget;
+	cacheHits = 0;
+	cacheMisses = 0;
+	cacheEvictedBytes = 0;
+	inflatedBytes = 0;
+	inflateTime = 0;
+	index = NULL;
+	table = NULL;
+	tableMask = 0;
+	fileNames = NULL;
+	namePool = NULL;
+	indexMap = NULL;
+	indexMapHandle = NULL;
+	indexMapSize = 0;
+
+	uint64_t grfSize = 0;
+	int64_t grfTime = 0;
+	//stat fails on grfs over 2gb with a 32 bit st_size
+#ifdef WIN32
+	struct __stat64 info;
+	if (_stat64(grfFile.c_str(), &info) == 0)
+#else
+	struct stat info;
+	if (stat(grfFile.c_str(), &info) == 0)
+#endif
+	{
+		grfSize = info.st_size;
+		grfTime = info.st_mtime;
+	}
+	else if (!indexCacheDirectory.empty())
+		Log::out << "Unable to get the size of " << grfFile << ", not using the index cache" << Log::newline;
+
+	//the cache file is named after the hash of the grf path; the full path is stored inside to catch collisions
+	std::string cacheFile;
+	if (!indexCacheDirectory.empty() && grfSize > 0)
+	{
+		char hash[16];
+		sprintf(hash, "%08x", hashFileName(grfFile.c_str()));
+		cacheFile = indexCacheDirectory + "/" + hash + ".grfidx";
+		if (loadIndexCache(cacheFile, grfFile, grfSize, grfTime))
+		{
+			Log::out << "Loaded GRF file " << grfFile << " using index cache" << Log::newline;
+			Log::out << index->nameCount << " files loaded" << Log::newline;
+			return;
+		}
+	}
+
+	GrfError error;
+	grf = grf_open(grfFile.c_str(), "rb", &error);
+	if (grf == NULL)
+	{
+		Log::err<<"Error opening GRF file: "<<grfFile<<Log::newline;
+		return;
+	}
+	Log::out<<"Loaded GRF file "<<grfFile<<Log::newline;
+	buildIndex(grfFile, grfSize, grfTime);
+	Log::out << index->nameCount << " files loaded"<< Log::newline;
+
+	if (!cacheFile.empty())
+	{
+#ifdef WIN32
+		_mkdir(indexCacheDirectory.c_str());
+#else
+		mkdir(indexCacheDirectory.c_str(), 0755);
+#endif
+		saveIndexCache(cacheFile);
+	}
+}
+
+unsigned int GrfFileSystemHandler::getFileCount() const
+{
+	return grf ? grf->nfiles : 0;
+}
+
+const char* GrfFileSystemHandler::getFileName(int index) const
+{
+	return grf->files[index].name;
+}
+
+void GrfFileSystemHandler::getFileStamp(int index, uint64_t &size, int64_t &modified) const
+{
+	size = grf->files[index].real_len;
+	modified = this->index->grfTime;
+}
+
+GrfFileSystemHandler::~GrfFileSystemHandler()
+{
+	if (grf)
+		logCacheStats();
+	grf_close(grf);
+	unmapIndexCache();
+	for (CacheEntry &entry : cache)
+		delete[] entry.data;
+}
+
+
+blib::util::StreamInFile* GrfFileSystemHandler::openRead( const std::string &fileName )
+{
+	if(!grf)
+		return NULL;
+	int index = find(fileName.c_str());
+	if(index == -1)
+		return NULL;
+	return openRead(index);
+}
+
+blib::util::StreamInFile* GrfFileSystemHandler::openRead(int index)
+{
+	GrfError error;
+	unsigned int size = 0;
+
+	//stored files are served straight from the mapped grf, without copying
+	const char* view = (const char*)grf_index_get_view(grf, index, &size, &error);
+	if (view)
+		return new blib::util::MemoryFile((char*)view, size, false);
+
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		auto cached = cacheLookup.find(index);
+		if (cached != cacheLookup.end())
+		{
+			cacheHits++;
+			cache.splice(cache.begin(), cache, cached->second);
+			return pin(cache.front());
+		}
+	}
+
+	//big files are only inflated as far as they are read, so probing their header doesn't extract everything
+	if (grf->files[index].real_len >= streamThreshold)
+		return openStream(index);
+	return extract(index);
+}
+
+//opens a compressed entry as a stream, without extracting it. The entry is only put in the cache if it is read to the end
+blib::util::StreamInFile* GrfFileSystemHandler::openStream(int index)
+{
+	GrfError error;
+	if (!grf || index < 0 || index >= (int)grf->nfiles)
+		return NULL;
+	GrfStream* stream = grf_index_stream_open(grf, index, &error);
+	if (!stream)
+		return NULL;
+	return new StreamFile(this, index, stream, grf->files[index].real_len, grf->files[index].real_len <= cacheBudget);
+}
+
+//extracts a file into the cache and opens it
+blib::util::StreamInFile* GrfFileSystemHandler::extract(int index)
+{
+	GrfError error;
+	unsigned int size = 0;
+
+	//extract without holding the lock, so other threads can read from the grf at the same time
+	char* data = new char[grf->files[index].real_len + 1];
+	auto start = std::chrono::steady_clock::now();
+	if (!grf_index_read(grf, index, data, &size, &error))
+	{
+		delete[] data;
+		return NULL;
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	data[size] = 0;
+	bool stored = grf_index_is_stored(grf, index) != 0; //stored files aren't inflated
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cacheMisses++;
+	if (!stored)
+	{
+		inflatedBytes += size;
+		inflateTime += elapsed.count();
+	}
+	auto cached = cacheLookup.find(index);
+	if (cached != cacheLookup.end()) //another thread extracted the same file in the meantime
+	{
+		delete[] data;
+		cache.splice(cache.begin(), cache, cached->second);
+		return pin(cache.front());
+	}
+	cache.push_front(CacheEntry{ index, data, size, 0 });
+	cacheLookup[index] = cache.begin();
+	cacheSize += size;
+	return pin(cache.front());
+}
+
+//opens a file on a cache entry. Needs cacheMutex to be locked
+blib::util::StreamInFile* GrfFileSystemHandler::pin(CacheEntry &entry)
+{
+	entry.pins++;
+	blib::util::StreamInFile* f = new CachedFile(this, entry.index, entry.data, entry.size);
+	evict();
+	return f;
+}
+
+//puts an entry that was inflated by a stream in the cache, unless another thread already extracted it
+void GrfFileSystemHandler::store(int index, const std::vector<char> &data)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	if (cacheLookup.find(index) != cacheLookup.end())
+		return;
+	char* copy = new char[data.size() + 1];
+	memcpy(copy, data.data(), data.size());
+	copy[data.size()] = 0;
+	cache.push_front(CacheEntry{ index, copy, (unsigned int)data.size(), 0 });
+	cacheLookup[index] = cache.begin();
+	cacheSize += data.size();
+	evict();
+}
+
+//extracts files into the cache ahead of time. The files are read in the order they are stored in the grf, and extracted on several threads
+void GrfFileSystemHandler::prefetch(std::vector<int> indices)
+{
+	if (!grf)
+		return;
+	std::sort(indices.begin(), indices.end());
+	indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		size_t total = 0;
+		indices.erase(std::remove_if(indices.begin(), indices.end(), [this, &total](int index)
+		{
+			GrfError error;
+			unsigned int size;
+			if (index < 0 || index >= (int)grf->nfiles || cacheLookup.find(index) != cacheLookup.end() || grf_index_get_view(grf, index, &size, &error) != NULL || GRFFILE_IS_DIR(grf->files[index]))
+				return true;
+			total += grf->files[index].real_len;
+			return total > cacheBudget; //don't prefetch more than fits, or the first files would be evicted again
+		}), indices.end());
+	}
+	std::sort(indices.begin(), indices.end(), [this](int a, int b) { return GRF_OffsetSort_Func(&grf->files[a], &grf->files[b]) < 0; });
+
+	std::vector<std::thread> threads;
+	std::atomic<size_t> next(0);
+	for (int t = 0; t < 8 && t < (int)indices.size(); t++)
+	{
+		threads.push_back(std::thread([this, &indices, &next]()
+		{
+			for (size_t i; (i = next++) < indices.size();)
+				delete extract(indices[i]);
+		}));
+	}
+	for (auto &t : threads)
+		t.join();
+}
+
+void GrfFileSystemHandler::getFileList( const std::string &path, std::vector<std::string> &files )
+{
+	if (!index)
+		return;
+	std::string directory = sanitizeFileName(path);
+	const uint32_t* end = fileNames + index->nameCount;
+	const uint32_t* it = std::lower_bound(fileNames, end, directory, [this](uint32_t name, const std::string &directory) { return directory.compare(namePool + name) > 0; });
+	for (; it != end && strncmp(namePool + *it, directory.c_str(), directory.size()) == 0; it++)
+	{
+		const char* name = namePool + *it;
+		if (strlen(name) <= directory.size() + 1 || strchr(name + directory.size() + 1, '\\') == NULL)
+			files.push_back(name);
+	}
+}
+
+void GrfFileSystemHandler::getFileList(const std::function<bool(const std::string&)> &filter, std::vector<std::string> &files)
+{
+	if (!index)
+		return;
+	for (uint32_t i = 0; i < index->nameCount; i++)
+	{
+		std::string fileName(namePool + fileNames[i]);
+		if (filter(fileName))
+			files.push_back(fileName);
+	}
+}
+
+size_t GrfFileSystemHandler::getCacheHits() const
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return cacheHits;
+}
+
+size_t GrfFileSystemHandler::getCacheMisses() const
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return cacheMisses;
+}
+
+size_t GrfFileSystemHandler::getCacheEvictedBytes() const
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return cacheEvictedBytes;
+}
+
+void GrfFileSystemHandler::logCacheStats()
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	Log::out << "Grf cache: " << cacheHits << " hits, " << cacheMisses << " misses, " << (cacheEvictedBytes / 1024) << "kb evicted, " << (cacheSize / 1024) << "kb in use" << Log::newline;
+	if (inflateTime > 0)
+		Log::out << "Grf inflate (" << GRF_InflateBackend() << "): " << (inflatedBytes / 1024) << "kb at " << (int)(inflatedBytes / inflateTime / (1024 * 1024)) << "MB/s" << Log::newline;
+}
+
+void GrfFileSystemHandler::unpin(int index)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto it = cacheLookup.find(index);
+	if (it == cacheLookup.end())
+		return;
+	it->second->pins--;
+	evict();
+}
+
+//drops the least recently used entries that aren't open until the cache fits its budget again. Needs cacheMutex to be locked
+void GrfFileSystemHandler::evict()
+{
+	auto it = cache.end();
+	while (cacheSize > cacheBudget && it != cache.begin())
+	{
+		--it;
+		if (it->pins > 0)
+			continue;
+		delete[] it->data;
+		cacheSize -= it->size;
+		cacheEvictedBytes += it->size;
+		cacheLookup.erase(it->index);
+		it = cache.erase(it);
+	}
+}
+
+
+GrfFileSystemHandler::CachedFile::CachedFile(GrfFileSystemHandler* handler, int index, char* data, unsigned int size) : blib::util::MemoryFile(data, size, false)
+{
+	this->handler = handler;
+	this->index = index;
+}
+
+GrfFileSystemHandler::CachedFile::~CachedFile()
+{
+	handler->unpin(index);
+}
+
+
+GrfFileSystemHandler::StreamFile::StreamFile(GrfFileSystemHandler* handler, int index, GrfStream* stream, unsigned int size, bool collect) : window(streamWindow)
+{
+	this->handler = handler;
+	this->index = index;
+	this->stream = stream;
+	this->size = size;
+	position = 0;
+	windowStart = 0;
+	windowSize = 0;
+	collecting = collect;
+}
+
+GrfFileSystemHandler::StreamFile::~StreamFile()
+{
+	grf_stream_close(stream);
+}
+
+//inflates the window starting at the current position
+bool GrfFileSystemHandler::StreamFile::fill()
+{
+	GrfError error;
+	windowSize = 0;
+	windowStart = position;
+	if (grf_stream_tell(stream) != position && !grf_stream_seek(stream, position, &error))
+		return false;
+	windowSize = grf_stream_read(stream, &window[0], (uint32_t)window.size(), &error);
+
+	//a seek past what was inflated so far leaves a gap, so the entry can't be cached from this stream anymore
+	if (collecting && windowStart > inflated.size())
+	{
+		collecting = false;
+		std::vector<char>().swap(inflated);
+	}
+	if (collecting && windowStart + windowSize > inflated.size())
+	{
+		inflated.insert(inflated.end(), window.begin() + (inflated.size() - windowStart), window.begin() + windowSize);
+		if (inflated.size() == size)
+		{
+			handler->store(index, inflated);
+			collecting = false;
+			std::vector<char>().swap(inflated);
+		}
+	}
+	return windowSize > 0;
+}
+
+unsigned int GrfFileSystemHandler::StreamFile::read(char* data, int count)
+{
+	unsigned int done = 0;
+	while (count > 0 && position < size)
+	{
+		if ((position < windowStart || position >= windowStart + windowSize) && !fill())
+			break;
+		unsigned int len = std::min((unsigned int)count, windowStart + windowSize - position);
+		memcpy(data + done, &window[position - windowStart], len);
+		position += len;
+		done += len;
+		count -= len;
+	}
+	return done;
+}
+
+char GrfFileSystemHandler::StreamFile::get()
+{
+	char c = 0;
+	read(&c, 1);
+	return c;
+}
+
+bool GrfFileSystemHandler::StreamFile::eof()
+{
+	return position >= size;
+}
+
+void GrfFileSystemHandler::StreamFile::seek(int offset, blib::util::StreamSeekable::StreamOffset offsetType)
+{
+	if (offsetType == blib::util::StreamSeekable::CURRENT)
+		offset += position;
+	else if (offsetType == blib::util::StreamSeekable::END)
+		offset += size;
+	position = (unsigned int)std::max(0, std::min(offset, (int)size));
+}
+
+unsigned int GrfFileSystemHandler::StreamFile::tell()
+{
+	return position;
+}
+
+bool GrfFileSystemHandler::StreamFile::opened()
+{
+	return stream != NULL;
+}
@@ -1,25 +1,164 @@
-#pragma once
-
-#include <blib/util/FileSystem.h>
-
-#include "grflib/grf.h"
-#include <map>
-
-
-
-class GrfFileSystemHandler : public blib::util::FileSystemHandler
-{
-	Grf* grf;
-	std::map<std::string, int> lookup;
-public:
-	GrfFileSystemHandler(const std::string &grfFile);
-	~GrfFileSystemHandler();
-
-	virtual blib::util::StreamInFile* openRead( const std::string &fileName );
-	virtual void getFileList( const std::string &path, std::vector<std::string> &files );
-	virtual void getFileList(const std::function<bool(const std::string&)> &filter, std::vector<std::string> &files);
-
-
-private:
-	std::string sanitizeFileName(std::string fileName);
-};
\ No newline at end of file
+#pragma once
+
+#include <blib/util/FileSystem.h>
+
+#include "grflib/grf.h"
+#include <map>
+#include <list>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+
+
+class GrfFileSystemHandler : public blib::util::FileSystemHandler
+{
+	//memoryfile over a cached grf entry, keeps the entry pinned in the cache while it is open
+	class CachedFile : public blib::util::MemoryFile
+	{
+		GrfFileSystemHandler* handler;
+		int index;
+	public:
+		CachedFile(GrfFileSystemHandler* handler, int index, char* data, unsigned int size);
+		~CachedFile();
+	};
+
+	//reads a compressed grf entry without extracting it, inflating a window at a time.
+	//While the windows are inflated front to back they are collected, and once the whole entry is inflated it goes into the cache
+	class StreamFile : public blib::util::StreamInFile
+	{
+		GrfFileSystemHandler* handler;
+		int index;
+		GrfStream* stream;
+		unsigned int size;
+		unsigned int position;
+		std::vector<char> window;
+		unsigned int windowStart;
+		unsigned int windowSize;
+		std::vector<char> inflated; //everything inflated so far, from the start of the entry
+		bool collecting;
+		bool fill();
+	public:
+		StreamFile(GrfFileSystemHandler* handler, int index, GrfStream* stream, unsigned int size, bool collect);
+		~StreamFile();
+		virtual unsigned int read(char* data, int count);
+		virtual char get();
+		virtual bool eof();
+		virtual void seek(int offset, blib::util::StreamSeekable::StreamOffset offsetType);
+		virtual unsigned int tell();
+		virtual bool opened();
+	};
+
+	class CacheEntry
+	{
+	public:
+		int index;
+		char* data;
+		unsigned int size;
+		int pins;
+	};
+
+	class HashSlot
+	{
+	public:
+		uint32_t hash;
+		int index; //index in grf->files, -1 for an empty slot
+	};
+
+	//the index is a single block, laid out the same in memory and in the index cache file
+	class IndexHeader
+	{
+	public:
+		char magic[8];
+		uint32_t version;
+		uint32_t nfiles;
+		uint64_t grfSize;
+		int64_t grfTime;
+		uint32_t tableSize;
+		uint32_t nameCount;
+		uint32_t filesOffset;
+		uint32_t tableOffset;
+		uint32_t namesOffset;
+		uint32_t poolOffset; //string pool, starts with the path of the grf
+		uint32_t size;
+		uint32_t padding;
+	};
+	class IndexFile
+	{
+	public:
+		uint32_t compressedLen;
+		uint32_t compressedLenAligned;
+		uint32_t realLen;
+		uint32_t pos;
+		uint32_t hash;
+		uint32_t name; //offset in the string pool
+		uint8_t flags;
+	};
+	static const char indexMagic[8];
+	static const uint32_t indexVersion = 1;
+
+	Grf* grf;
+	const IndexHeader* index;
+	const HashSlot* table; //open addressing on the sanitized filename
+	uint32_t tableMask;
+	const uint32_t* fileNames; //sanitized and sorted, as offsets in namePool, for getFileList
+	const char* namePool;
+
+	std::vector<char> indexData; //the index block, if it was built instead of mapped from the cache
+	void* indexMap;
+	void* indexMapHandle;
+	size_t indexMapSize;
+
+	mutable std::mutex cacheMutex;
+	std::list<CacheEntry> cache; //most recently used entry at the front, the entries own their data
+	std::map<int, std::list<CacheEntry>::iterator> cacheLookup;
+	size_t cacheSize;
+	size_t cacheBudget;
+
+	size_t cacheHits;
+	size_t cacheMisses;
+	size_t cacheEvictedBytes;
+	size_t inflatedBytes;
+	double inflateTime;
+public:
+	GrfFileSystemHandler(const std::string &grfFile, size_t cacheBudget = 256 * 1024 * 1024, const std::string &indexCacheDirectory = "");
+	~GrfFileSystemHandler();
+
+	virtual blib::util::StreamInFile* openRead( const std::string &fileName );
+	virtual void getFileList( const std::string &path, std::vector<std::string> &files );
+	virtual void getFileList(const std::function<bool(const std::string&)> &filter, std::vector<std::string> &files);
+
+	//direct access to the entries of the grf, for indices that span multiple archives
+	int find(const char* fileName) const;
+	unsigned int getFileCount() const;
+	const char* getFileName(int index) const;
+	//size of an entry and the modification time of the grf, to tell if an entry may have changed without extracting it
+	void getFileStamp(int index, uint64_t &size, int64_t &modified) const;
+	blib::util::StreamInFile* openRead(int index);
+	blib::util::StreamInFile* openStream(int index);
+	void prefetch(std::vector<int> indices);
+
+	size_t getCacheHits() const;
+	size_t getCacheMisses() const;
+	size_t getCacheEvictedBytes() const;
+	void logCacheStats();
+
+	static unsigned int streamThreshold; //files this big are streamed by openRead, and only cached once they are read to the end
+	static unsigned int streamWindow;
+
+	static std::string sanitizeFileName(const std::string &fileName);
+	static uint32_t hashFileName(const char* fileName);
+	static bool equalFileNames(const char* a, const char* b);
+
+private:
+	void buildIndex(const std::string &grfFile, uint64_t grfSize, int64_t grfTime);
+	void setIndex(const char* data);
+	bool loadIndexCache(const std::string &cacheFile, const std::string &grfFile, uint64_t grfSize, int64_t grfTime);
+	void unmapIndexCache();
+	void saveIndexCache(const std::string &cacheFile);
+	blib::util::StreamInFile* extract(int index);
+	blib::util::StreamInFile* pin(CacheEntry &entry);
+	void store(int index, const std::vector<char> &data);
+	void unpin(int index);
+	void evict();
+};
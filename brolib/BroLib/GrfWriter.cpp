@@ -0,0 +1,102 @@
+#include "GrfWriter.h"
+#include <blib/util/Log.h>
+using blib::util::Log;
+
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+
+
+GrfWriter::GrfWriter(const std::string &grfFile)
+{
+	GrfError error;
+	this->grfFile = grfFile;
+
+	//add to the archive if it exists, otherwise create a new one
+	FILE* f = fopen(grfFile.c_str(), "rb");
+	if (f)
+		fclose(f);
+	grf = grf_open(grfFile.c_str(), f ? "r+b" : "w+b", &error);
+	if (!grf)
+		Log::err << "GrfWriter: could not open " << grfFile << ": " << grf_strerror(error) << Log::newline;
+}
+
+GrfWriter::~GrfWriter()
+{
+	if (grf)
+		grf_close(grf);
+}
+
+void GrfWriter::add(const std::string &name, const char* data, size_t size)
+{
+	Entry entry;
+	entry.name = name;
+	std::replace(entry.name.begin(), entry.name.end(), '/', '\\');
+	entry.data.assign(data, data + size);
+	entries.push_back(std::move(entry));
+}
+
+bool GrfWriter::addFile(const std::string &name, const std::string &fileName)
+{
+	FILE* f = fopen(fileName.c_str(), "rb");
+	if (!f)
+	{
+		Log::err << "GrfWriter: could not read " << fileName << Log::newline;
+		return false;
+	}
+	std::vector<char> data;
+	char buf[64 * 1024];
+	size_t len;
+	while ((len = fread(buf, 1, sizeof(buf), f)) > 0)
+		data.insert(data.end(), buf, buf + len);
+	fclose(f);
+	add(name, data.data(), data.size());
+	return true;
+}
+
+//deflates all added files on several threads, then writes them to the archive in one go
+bool GrfWriter::write()
+{
+	if (!grf)
+		return false;
+
+	std::vector<std::thread> threads;
+	std::atomic<size_t> next(0);
+	for (int t = 0; t < 8 && t < (int)entries.size(); t++)
+	{
+		threads.push_back(std::thread([this, &next]()
+		{
+			for (size_t i; (i = next++) < entries.size();)
+			{
+				Entry &entry = entries[i];
+				uLongf len = compressBound((uLong)entry.data.size());
+				entry.compressed.resize(len);
+				if (compress((Bytef*)entry.compressed.data(), &len, (const Bytef*)entry.data.data(), (uLong)entry.data.size()) != Z_OK)
+					len = 0;
+				entry.compressed.resize(len);
+			}
+		}));
+	}
+	for (auto &t : threads)
+		t.join();
+
+	GrfError error;
+	for (const Entry &entry : entries)
+	{
+		if (entry.compressed.empty() || !grf_put_z(grf, entry.name.c_str(), entry.compressed.data(), (uint32_t)entry.compressed.size(), (uint32_t)entry.data.size(), &error))
+		{
+			Log::err << "GrfWriter: could not add " << entry.name << " to " << grfFile << Log::newline;
+			return false;
+		}
+	}
+	if (!grf_flush(grf, &error))
+	{
+		Log::err << "GrfWriter: could not write " << grfFile << ": " << grf_strerror(error) << Log::newline;
+		return false;
+	}
+	Log::out << "GrfWriter: wrote " << entries.size() << " files to " << grfFile << Log::newline;
+	entries.clear();
+	return true;
+}
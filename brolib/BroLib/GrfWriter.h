@@ -0,0 +1,30 @@
+#pragma once
+
+#include "grflib/grf.h"
+#include <string>
+#include <vector>
+
+//adds files to a grf archive. The files are deflated on several threads, then appended to the archive together with a new file table,
+//so the rest of the archive doesn't have to be rewritten
+class GrfWriter
+{
+	class Entry
+	{
+	public:
+		std::string name;
+		std::vector<char> data;
+		std::vector<char> compressed;
+	};
+
+	Grf* grf;
+	std::string grfFile;
+	std::vector<Entry> entries;
+public:
+	GrfWriter(const std::string &grfFile);
+	~GrfWriter();
+
+	bool opened() const { return grf != NULL; }
+	void add(const std::string &name, const char* data, size_t size);
+	bool addFile(const std::string &name, const std::string &fileName);
+	bool write();
+};
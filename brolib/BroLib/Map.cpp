@@ -1,381 +1,489 @@
-#include "Map.h"
-#include "Gnd.h"
-#include "Rsw.h"
-#include "Gat.h"
-
-#include <blib/util/stb_image_create.h>
-#include <blib/util/stb_image.h>
-#include <blib/BackgroundTask.h>
-#include <blib/util/Log.h>
-using blib::util::Log;
-
-#include <fstream>
-
-
-
-Map::Map( const std::string &fileName )
-{
-	this->fileName = fileName;
-	Log::out<<"Map: loading map "<<fileName<<Log::newline;
-
-	//TODO: for some reason it doesn't like to parallalize these tasks...investigate later
-#if 0
-	blib::BackgroundTask<int>* gndTask = new blib::BackgroundTask<int>(NULL, [this, fileName]() { gnd = new Gnd(fileName); return 0; });
-	blib::BackgroundTask<int>* rswTask = new blib::BackgroundTask<int>(NULL, [this, fileName]() { rsw = new Rsw(fileName); return 0; });
-	blib::BackgroundTask<int>* gatTask = new blib::BackgroundTask<int>(NULL, [this, fileName]() { gat = new Gat(fileName); return 0; });
-	gndTask->waitForTermination();
-	rswTask->waitForTermination();
-	gatTask->waitForTermination();
-#else
-	gnd = new Gnd(fileName);
-	rsw = new Rsw(fileName);
-	gat = new Gat(fileName);
-#endif
-	Log::out<<"Map: Done loading map"<<Log::newline;
-}
-
-
-Map::Map(const std::string &fileName, int width, int height)
-{
-	Log::out << "Map: New map " << fileName << " of " << width << "x" << height << Log::newline;
-	this->fileName = fileName;
-
-	gnd = new Gnd(width, height);
-	rsw = new Rsw(width, height);
-	gat = new Gat(width*2, height*2);
-}
-
-Map::~Map()
-{
-	delete gnd;
-	delete rsw;
-	delete gat;
-	gnd = NULL;
-	rsw = NULL;
-	gat = NULL;
-}
-
-
-void Map::save(const std::string &filename)
-{
-	if (filename != "")
-		this->fileName = filename;
-
-	gnd->save(this->fileName);
-	rsw->recalculateQuadTree(gnd);
-	rsw->save(this->fileName);
-	gat->save(this->fileName);
-}
-
-bool Map::inMap(int x, int y)
-{
-	return x >= 0 && x < gnd->width && y >= 0 && y < gnd->height;
-}
-
-void Map::saveHeightmap( const std::string &fileName )
-{
-	char* data = new char[(gnd->width * 2 )  * (gnd->height * 2) * 3];
-	float minHeight = 999999;
-	float maxHeight = -999999;
-	for (int y = 0; y < gnd->height; y++)
-	{
-		for (int x = 0; x < gnd->width; x++)
-		{
-			for (int i = 0; i < 4; i++)
-			{
-				minHeight = glm::min(minHeight, gnd->cubes[x][y]->heights[i]);
-				maxHeight = glm::max(maxHeight, gnd->cubes[x][y]->heights[i]);
-			}
-		}
-	}
-
-	for (int y = 0; y < gnd->height; y++)
-	{
-		for (int x = 0; x < gnd->width; x++)
-		{
-			for (int i = 0; i < 4; i++)
-			{
-				int xx = i % 2;
-				int yy = i / 2;
-				int index = ((2 * x + xx) + (gnd->width * 2) * (2 * y + yy)) * 3;
-				for (int ii = 0; ii < 3; ii++)
-					data[index+ii] = (unsigned char)((gnd->cubes[x][y]->heights[i] - minHeight) * (255 / (maxHeight - minHeight)));
-			}
-		}
-	}
-
-	stbi_write_png(fileName.c_str(), gnd->width * 2, gnd->height * 2, 3, data, 0);
-	delete[] data;
-}
-
-void Map::loadHeightmap(const std::string &fileName)
-{
-	int width, height, comp;
-
-	unsigned char* data = stbi_load(fileName.c_str(), &width, &height, &comp, 3);
-	if (!data || width != gnd->width * 2 || height != gnd->height * 2)
-	{
-		if (data)
-			stbi_image_free(data);
-		return;
-	}
-
-
-	heightImportCubes.resize(width/2, std::vector<Gnd::Cube>(height/2));
-
-	float minHeight = 999999;
-	float maxHeight = -999999;
-	for (int y = 0; y < gnd->height; y++)
-	{
-		for (int x = 0; x < gnd->width; x++)
-		{
-			for (int i = 0; i < 4; i++)
-			{
-				minHeight = glm::min(minHeight, gnd->cubes[x][y]->heights[i]);
-				maxHeight = glm::max(maxHeight, gnd->cubes[x][y]->heights[i]);
-			}
-		}
-	}
-
-	for (int y = 0; y < gnd->height; y++)
-	{
-		for (int x = 0; x < gnd->width; x++)
-		{
-			for (int i = 0; i < 4; i++)
-			{
-				int xx = i % 2;
-				int yy = i / 2;
-				int index = ((2 * x + xx) + (gnd->width * 2) * (2 * y + yy)) * 3;
-				heightImportCubes[x][y].heights[i] = data[index] / 255.0f;
-			}
-		}
-	}
-
-	heightImportMin = 350;
-	heightImportMax = 1050;
-
-	stbi_image_free(data);
-}
-
-
-void Map::exportLightmap(const std::string &fileName)
-{
-	char* data = new char[(gnd->width * 6)  * (gnd->height * 6) * 3];
-
-	for (int y = 0; y < gnd->height; y++)
-	{
-		for (int x = 0; x < gnd->width; x++)
-		{
-			for (int xx = 0; xx < 6; xx++)
-			{
-				for (int yy = 0; yy < 6; yy++)
-				{
-					for (int i = 0; i < 4; i++)
-					{
-						int brightness = gnd->getLightmapBrightness(x, y, xx + 1, yy + 1);
-
-						int index = ((6 * x + xx) + (gnd->width * 6) * (6 * y + yy)) * 3;
-						for (int ii = 0; ii < 3; ii++)
-							data[index + ii] = brightness;
-					}
-				}
-			}
-		}
-	}
-
-	stbi_write_png(fileName.c_str(), gnd->width * 6, gnd->height * 6, 3, data, 0);
-	delete[] data;
-}
-
-void Map::exportObj(const std::string &fileName)
-{
-	std::ofstream file(fileName);
-
-
-	for (int x = 0; x < gnd->width; x++)
-	{
-		for (int y = 0; y < gnd->height; y++)
-		{
-			auto cube = gnd->cubes[x][y];
-			file << "v " << (x + 0) * 10 << " " << -cube->heights[2] << " " << 10 * gnd->height - (y + 1) * 10 +10<< std::endl;
-			file << "v " << (x + 0) * 10 << " " << -cube->heights[0] << " " << 10 * gnd->height - (y + 0) * 10 +10<< std::endl;
-			file << "v " << (x + 1) * 10 << " " << -cube->heights[1] << " " << 10 * gnd->height - (y + 0) * 10 +10<< std::endl;
-			file << "v " << (x + 1) * 10 << " " << -cube->heights[3] << " " << 10 * gnd->height - (y + 1) * 10 +10<< std::endl;
-		}
-	}
-
-	for (int x = 0; x < gnd->width; x++)
-	{
-		for (int y = 0; y < gnd->height; y++)
-		{
-			if (gnd->cubes[x][y]->tileUp != -1)
-			{
-				file << "f ";
-				for (int i = 0; i < 4; i++)
-					file << (x + y * gnd->width) * 4 + i + 1 << " ";
-				file << std::endl;
-			}
-			if (gnd->cubes[x][y]->tileSide != -1)
-			{
-				file << "f ";
-				file << (x + y * gnd->width) * 4 + 2 + 1 << " ";
-				file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
-				file << (x + (y+1) * gnd->width) * 4 + 0 + 1 << " ";
-				file << (x + (y+1) * gnd->width) * 4 + 1 + 1 << " ";
-				file << std::endl;
-			}
-
-			if (gnd->cubes[x][y]->tileFront != -1)
-			{
-				file << "f ";
-				file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
-				file << (x + y * gnd->width) * 4 + 0 + 1 << " ";
-				file << ((x+1) + y * gnd->width) * 4 + 1 + 1 << " ";
-				file << ((x+1) + y * gnd->width) * 4 + 2 + 1 << " ";
-				file << std::endl;
-			}
-		}
-	}
-
-	int index = gnd->width * gnd->height * 4;
-	int currentIndex = index + 1;
-
-	for (auto o : rsw->objects)
-	{
-
-		if (o->type == Rsw::Object::Type::Model)
-		{
-			auto model = dynamic_cast<Rsw::Model*>(o);
-			std::vector<int> indices;
-			std::vector<glm::vec3> vertices;
-
-			model->getWorldVerts(indices, vertices);
-
-
-			for (const auto &v : vertices)
-			{
-				file << "v " << v.x << " " << v.y << " " << v.z << std::endl;
-			}
-
-			for (int i = 0; i < indices.size(); i+=3)
-			{
-				file << "f ";
-				for (int ii = 0; ii < 3; ii++)
-					file << (currentIndex + (i+ii)) << " ";
-				file << std::endl;
-			}
-			currentIndex += vertices.size();
-		}
-
-
-	}
-
-	
-}
-
-
-
-
-
-std::vector<glm::vec3> Map::getMapQuads()
-{
-	std::vector<glm::vec3> quads;
-
-	for (int x = 0; x < gnd->width; x++)
-	{
-		for (int y = 0; y < gnd->height; y++)
-		{
-			auto cube = gnd->cubes[x][y];
-			if (cube->tileUp != -1)
-			{
-				/*quads.push_back(glm::vec3((x + 0) * 10, -cube->heights[2], 10 * gnd->height - (y + 1) * 10 + 10));
-				quads.push_back(glm::vec3((x + 0) * 10, -cube->heights[0], 10 * gnd->height - (y + 0) * 10 + 10));
-				quads.push_back(glm::vec3((x + 1) * 10, -cube->heights[1], 10 * gnd->height - (y + 0) * 10 + 10));
-				quads.push_back(glm::vec3((x + 1) * 10, -cube->heights[3], 10 * gnd->height - (y + 1) * 10 + 10));*/
-			}
-			if (cube->tileSide != -1)
-			{
-				quads.push_back(glm::vec3(10 * x, -cube->h3, 10 * gnd->height - 10 * y));
-				quads.push_back(glm::vec3(10 * x + 10, -cube->h4, 10 * gnd->height - 10 * y));
-				quads.push_back(glm::vec3(10 * x + 10, -gnd->cubes[x][y + 1]->h2, 10 * gnd->height - 10 * y));
-				quads.push_back(glm::vec3(10 * x, -gnd->cubes[x][y + 1]->h1, 10 * gnd->height - 10 * y));
-			}
-			if (cube->tileFront != -1)
-			{
-				quads.push_back(glm::vec3(10 * x + 10, -cube->h2, 10 * gnd->height - 10 * y + 10));
-				quads.push_back(glm::vec3(10 * x + 10, -cube->h4, 10 * gnd->height - 10 * y));
-				quads.push_back(glm::vec3(10 * x + 10, -gnd->cubes[x + 1][y]->h3, 10 * gnd->height - 10 * y));
-				quads.push_back(glm::vec3(10 * x + 10, -gnd->cubes[x + 1][y]->h1, 10 * gnd->height - 10 * y + 10));
-			}
-		}
-	}
-
-		/*for (int x = 0; x < gnd->width; x++)
-		{
-			for (int y = 0; y < gnd->height; y++)
-			{
-				if (gnd->cubes[x][y]->tileUp != -1)
-				{
-					file << "f ";
-					for (int i = 0; i < 4; i++)
-						file << (x + y * gnd->width) * 4 + i + 1 << " ";
-					file << std::endl;
-				}
-				if (gnd->cubes[x][y]->tileSide != -1)
-				{
-					file << "f ";
-					file << (x + y * gnd->width) * 4 + 2 + 1 << " ";
-					file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
-					file << (x + (y + 1) * gnd->width) * 4 + 0 + 1 << " ";
-					file << (x + (y + 1) * gnd->width) * 4 + 1 + 1 << " ";
-					file << std::endl;
-				}
-
-				if (gnd->cubes[x][y]->tileFront != -1)
-				{
-					file << "f ";
-					file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
-					file << (x + y * gnd->width) * 4 + 0 + 1 << " ";
-					file << ((x + 1) + y * gnd->width) * 4 + 1 + 1 << " ";
-					file << ((x + 1) + y * gnd->width) * 4 + 2 + 1 << " ";
-					file << std::endl;
-				}
-			}
-		}*/
-	return quads;
-}
-
-glm::vec4 Map::getHeightsAt(int x, int y)
-{
-	assert(inMap(x, y));
-	float ret[4];
-
-	for (int i = 0; i < 4; i++)
-	{
-		int xx = i % 2;
-		int yy = i / 2;
-		if (inMap(x - xx, y - yy))
-			ret[i] = gnd->cubes[x - xx][y - yy]->heights[i];
-		else
-			ret[i] = gnd->cubes[x][y]->heights[0];
-	}
-	return glm::vec4(ret[0], ret[1], ret[2], ret[3]);
-}
-
-
-float Map::getHeightAt(float x, float y)
-{
-	int ix = (int)x;
-	int iy = (int)y;
-
-	if (!inMap(ix, iy))
-		return 0;
-
-	//TODO: use barycentric coordinats
-	Gnd::Cube* c = gnd->cubes[ix][iy];
-	return (c->h1 + c->h2 + c->h3 + c->h4) / 4.0f;
-}
-
-
-template class blib::BackgroundTask<int>;
-
+#include "Map.h"
+#include "Gnd.h"
+#include "Rsw.h"
+#include "Gat.h"
+#include "Rsm.h"
+#include "OverlayFileSystemHandler.h"
+#include "GrfWriter.h"
+#include "WorkspaceCache.h"
+
+#include <blib/util/stb_image_create.h>
+#include <blib/util/stb_image.h>
+#include <blib/BackgroundTask.h>
+#include <blib/util/Log.h>
+using blib::util::Log;
+
+#include <fstream>
+#include <thread>
+#include <chrono>
+
+static double elapsedMs(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+
+Map::Map( const std::string &fileName, bool deferModels )
+{
+	this->fileName = fileName;
+	Log::out<<"Map: loading map "<<fileName<<Log::newline;
+
+	auto start = std::chrono::steady_clock::now();
+	OverlayFileSystemHandler::prefetchAll({ fileName + ".gnd", fileName + ".rsw", fileName + ".gat" });
+	Log::out << "Map: prefetched map files in " << elapsedMs(start) << "ms" << Log::newline;
+
+	//the three files don't depend on each other, so they are parsed at the same time. The rsw loads its models on a pool of its own.
+	//The gnd and gat come from the workspace cache instead if the map was opened before and hasn't changed since
+	double gndTime = 0, rswTime = 0, gatTime = 0;
+	std::thread rswThread([this, &fileName, &rswTime, deferModels]() { auto begin = std::chrono::steady_clock::now(); rsw = new Rsw(fileName, !deferModels); rswTime = elapsedMs(begin); });
+	auto cacheStart = std::chrono::steady_clock::now();
+	bool cached = WorkspaceCache::load(fileName, gnd, gat);
+	if (cached)
+		Log::out << "Map: loaded gnd and gat from the workspace cache in " << elapsedMs(cacheStart) << "ms" << Log::newline;
+	else
+	{
+		std::thread gndThread([this, &fileName, &gndTime]() { auto begin = std::chrono::steady_clock::now(); gnd = new Gnd(fileName); gndTime = elapsedMs(begin); });
+		std::thread gatThread([this, &fileName, &gatTime]() { auto begin = std::chrono::steady_clock::now(); gat = new Gat(fileName); gatTime = elapsedMs(begin); });
+		gndThread.join();
+		gatThread.join();
+	}
+	rswThread.join();
+	Log::out << "Map: gnd " << gndTime << "ms, rsw " << rswTime << "ms, gat " << gatTime << "ms" << Log::newline;
+	if (!cached)
+		WorkspaceCache::save(fileName, gnd, gat);
+	if (deferModels)
+		rsw->loadModelsInBackground(gnd);
+
+	//the renderer loads all textures right after this, have them ready
+	auto textureStart = std::chrono::steady_clock::now();
+	std::vector<std::string> textureFiles;
+	for (Gnd::Texture* texture : gnd->textures)
+		textureFiles.push_back("data/texture/" + texture->file);
+	//the loader threads can still be filling the rsm cache, so it is copied under its lock. With deferred models the loaders
+	//prefetch the textures of each model themselves
+	std::map<std::string, Rsm*> models;
+	{
+		std::lock_guard<std::mutex> lock(rsw->rsmCacheMutex);
+		models = rsw->rsmCache;
+	}
+	for (auto rsm : models)
+		if (rsm.second)
+			for (const std::string &texture : rsm.second->textures)
+				textureFiles.push_back("data/texture/" + texture);
+	OverlayFileSystemHandler::prefetchAll(textureFiles);
+	Log::out << "Map: prefetched " << textureFiles.size() << " textures in " << elapsedMs(textureStart) << "ms" << Log::newline;
+
+	Log::out<<"Map: Done loading map in "<<elapsedMs(start)<<"ms"<<Log::newline;
+}
+
+
+Map::Map(const std::string &fileName, int width, int height)
+{
+	Log::out << "Map: New map " << fileName << " of " << width << "x" << height << Log::newline;
+	this->fileName = fileName;
+
+	gnd = new Gnd(width, height);
+	rsw = new Rsw(width, height);
+	gat = new Gat(width*2, height*2);
+}
+
+Map::~Map()
+{
+	delete gnd;
+	delete rsw;
+	delete gat;
+	gnd = NULL;
+	rsw = NULL;
+	gat = NULL;
+}
+
+
+Map::SaveState* Map::prepareSave(const std::string &filename)
+{
+	if (filename != "")
+		this->fileName = filename;
+
+	auto start = std::chrono::steady_clock::now();
+	SaveState* state = new SaveState();
+	state->fileName = fileName;
+	//the quadtree needs the models, and the rsw is small, so it is serialized right away instead of copied
+	rsw->waitForModels(gnd);
+	rsw->recalculateQuadTree(gnd);
+	rsw->save(state->rsw, state->extra);
+	state->gnd = new Gnd(*gnd);
+	state->gat = new Gat(*gat);
+	Log::out << "Map: copied map for saving in " << elapsedMs(start) << "ms" << Log::newline;
+	return state;
+}
+
+Map::SaveState::~SaveState()
+{
+	delete gnd;
+	delete gat;
+}
+
+bool Map::SaveState::write(const std::function<void(float)> &progress)
+{
+	auto report = [&progress](float value) { if (progress) progress(value); };
+	auto start = std::chrono::steady_clock::now();
+	report(0);
+	//only the copy is compacted, so saving doesn't move the tiles and lightmaps of the map that is being edited
+	gnd->compact();
+	report(0.1f);
+	BufferWriter gndWriter;
+	gnd->save(gndWriter);
+	report(0.3f);
+	BufferWriter gatWriter;
+	gat->save(gatWriter);
+	report(0.4f);
+
+	bool ok = gndWriter.save(fileName + ".gnd");
+	report(0.6f);
+	ok = ok && rsw.save(fileName + ".rsw") && extra.save(fileName + ".extra.json");
+	report(0.7f);
+	ok = ok && gatWriter.save(fileName + ".gat");
+	report(0.8f);
+	if (ok)
+		WorkspaceCache::saveWritten(fileName, gnd, gat, gndWriter.data(), gatWriter.data());
+	report(1);
+	if (ok)
+		Log::out << "Map: saved " << fileName << " in " << elapsedMs(start) << "ms, " << ((gndWriter.size() + rsw.size() + gatWriter.size()) / 1024) << "kb" << Log::newline;
+	else
+		Log::err << "Map: unable to save " << fileName << Log::newline;
+	return ok;
+}
+
+//saves the map, and puts the saved files in a grf so they can be used by the client without repacking
+bool Map::SaveState::writeToGrf(const std::string &grfFile, const std::function<void(float)> &progress)
+{
+	if (!write([&progress](float value) { if (progress) progress(value * 0.8f); }))
+		return false;
+	GrfWriter writer(grfFile);
+	if (!writer.opened())
+		return false;
+	for (const char* extension : { ".gnd", ".rsw", ".gat", ".extra.json" })
+		if (!writer.addFile(fileName + extension, fileName + extension))
+			return false;
+	bool ok = writer.write();
+	if (progress)
+		progress(1);
+	return ok;
+}
+
+void Map::save(const std::string &filename)
+{
+	SaveState* state = prepareSave(filename);
+	state->write();
+	delete state;
+}
+
+bool Map::saveToGrf(const std::string &grfFile)
+{
+	SaveState* state = prepareSave("");
+	bool ok = state->writeToGrf(grfFile);
+	delete state;
+	return ok;
+}
+
+bool Map::inMap(int x, int y)
+{
+	return x >= 0 && x < gnd->width && y >= 0 && y < gnd->height;
+}
+
+void Map::saveHeightmap( const std::string &fileName )
+{
+	char* data = new char[(gnd->width * 2 )  * (gnd->height * 2) * 3];
+	float minHeight = 999999;
+	float maxHeight = -999999;
+	for (size_t i = 0; i < gnd->cubeHeights.size(); i++)
+	{
+		minHeight = glm::min(minHeight, gnd->cubeHeights[i]);
+		maxHeight = glm::max(maxHeight, gnd->cubeHeights[i]);
+	}
+
+	for (int y = 0; y < gnd->height; y++)
+	{
+		for (int x = 0; x < gnd->width; x++)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				int xx = i % 2;
+				int yy = i / 2;
+				int index = ((2 * x + xx) + (gnd->width * 2) * (2 * y + yy)) * 3;
+				for (int ii = 0; ii < 3; ii++)
+					data[index+ii] = (unsigned char)((gnd->cube(x, y).heights[i] - minHeight) * (255 / (maxHeight - minHeight)));
+			}
+		}
+	}
+
+	stbi_write_png(fileName.c_str(), gnd->width * 2, gnd->height * 2, 3, data, 0);
+	delete[] data;
+}
+
+void Map::loadHeightmap(const std::string &fileName)
+{
+	int width, height, comp;
+
+	unsigned char* data = stbi_load(fileName.c_str(), &width, &height, &comp, 3);
+	if (!data || width != gnd->width * 2 || height != gnd->height * 2)
+	{
+		if (data)
+			stbi_image_free(data);
+		return;
+	}
+
+
+	heightImportCubes.resize(width/2, std::vector<glm::vec4>(height/2));
+
+	float minHeight = 999999;
+	float maxHeight = -999999;
+	for (size_t i = 0; i < gnd->cubeHeights.size(); i++)
+	{
+		minHeight = glm::min(minHeight, gnd->cubeHeights[i]);
+		maxHeight = glm::max(maxHeight, gnd->cubeHeights[i]);
+	}
+
+	for (int y = 0; y < gnd->height; y++)
+	{
+		for (int x = 0; x < gnd->width; x++)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				int xx = i % 2;
+				int yy = i / 2;
+				int index = ((2 * x + xx) + (gnd->width * 2) * (2 * y + yy)) * 3;
+				heightImportCubes[x][y][i] = data[index] / 255.0f;
+			}
+		}
+	}
+
+	heightImportMin = 350;
+	heightImportMax = 1050;
+
+	stbi_image_free(data);
+}
+
+
+void Map::exportLightmap(const std::string &fileName)
+{
+	char* data = new char[(gnd->width * 6)  * (gnd->height * 6) * 3];
+
+	for (int y = 0; y < gnd->height; y++)
+	{
+		for (int x = 0; x < gnd->width; x++)
+		{
+			for (int xx = 0; xx < 6; xx++)
+			{
+				for (int yy = 0; yy < 6; yy++)
+				{
+					for (int i = 0; i < 4; i++)
+					{
+						int brightness = gnd->getLightmapBrightness(x, y, xx + 1, yy + 1);
+
+						int index = ((6 * x + xx) + (gnd->width * 6) * (6 * y + yy)) * 3;
+						for (int ii = 0; ii < 3; ii++)
+							data[index + ii] = brightness;
+					}
+				}
+			}
+		}
+	}
+
+	stbi_write_png(fileName.c_str(), gnd->width * 6, gnd->height * 6, 3, data, 0);
+	delete[] data;
+}
+
+void Map::exportObj(const std::string &fileName)
+{
+	rsw->waitForModels(gnd);
+	std::ofstream file(fileName);
+
+
+	for (int y = 0; y < gnd->height; y++)
+	{
+		for (int x = 0; x < gnd->width; x++)
+		{
+			auto cube = gnd->cube(x, y);
+			file << "v " << (x + 0) * 10 << " " << -cube.heights[2] << " " << 10 * gnd->height - (y + 1) * 10 +10<< std::endl;
+			file << "v " << (x + 0) * 10 << " " << -cube.heights[0] << " " << 10 * gnd->height - (y + 0) * 10 +10<< std::endl;
+			file << "v " << (x + 1) * 10 << " " << -cube.heights[1] << " " << 10 * gnd->height - (y + 0) * 10 +10<< std::endl;
+			file << "v " << (x + 1) * 10 << " " << -cube.heights[3] << " " << 10 * gnd->height - (y + 1) * 10 +10<< std::endl;
+		}
+	}
+
+	for (int y = 0; y < gnd->height; y++)
+	{
+		for (int x = 0; x < gnd->width; x++)
+		{
+			if (gnd->cube(x, y).tileUp != -1)
+			{
+				file << "f ";
+				for (int i = 0; i < 4; i++)
+					file << (x + y * gnd->width) * 4 + i + 1 << " ";
+				file << std::endl;
+			}
+			if (gnd->cube(x, y).tileSide != -1)
+			{
+				file << "f ";
+				file << (x + y * gnd->width) * 4 + 2 + 1 << " ";
+				file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
+				file << (x + (y+1) * gnd->width) * 4 + 0 + 1 << " ";
+				file << (x + (y+1) * gnd->width) * 4 + 1 + 1 << " ";
+				file << std::endl;
+			}
+
+			if (gnd->cube(x, y).tileFront != -1)
+			{
+				file << "f ";
+				file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
+				file << (x + y * gnd->width) * 4 + 0 + 1 << " ";
+				file << ((x+1) + y * gnd->width) * 4 + 1 + 1 << " ";
+				file << ((x+1) + y * gnd->width) * 4 + 2 + 1 << " ";
+				file << std::endl;
+			}
+		}
+	}
+
+	int index = gnd->width * gnd->height * 4;
+	int currentIndex = index + 1;
+
+	for (auto o : rsw->objects)
+	{
+
+		if (o->type == Rsw::Object::Type::Model)
+		{
+			auto model = dynamic_cast<Rsw::Model*>(o);
+			std::vector<int> indices;
+			std::vector<glm::vec3> vertices;
+
+			model->getWorldVerts(indices, vertices);
+
+
+			for (const auto &v : vertices)
+			{
+				file << "v " << v.x << " " << v.y << " " << v.z << std::endl;
+			}
+
+			for (int i = 0; i < indices.size(); i+=3)
+			{
+				file << "f ";
+				for (int ii = 0; ii < 3; ii++)
+					file << (currentIndex + (i+ii)) << " ";
+				file << std::endl;
+			}
+			currentIndex += vertices.size();
+		}
+
+
+	}
+
+	
+}
+
+
+
+
+
+std::vector<glm::vec3> Map::getMapQuads()
+{
+	std::vector<glm::vec3> quads;
+
+	for (int y = 0; y < gnd->height; y++)
+	{
+		for (int x = 0; x < gnd->width; x++)
+		{
+			auto cube = gnd->cube(x, y);
+			if (cube.tileUp != -1)
+			{
+				/*quads.push_back(glm::vec3((x + 0) * 10, -cube.heights[2], 10 * gnd->height - (y + 1) * 10 + 10));
+				quads.push_back(glm::vec3((x + 0) * 10, -cube.heights[0], 10 * gnd->height - (y + 0) * 10 + 10));
+				quads.push_back(glm::vec3((x + 1) * 10, -cube.heights[1], 10 * gnd->height - (y + 0) * 10 + 10));
+				quads.push_back(glm::vec3((x + 1) * 10, -cube.heights[3], 10 * gnd->height - (y + 1) * 10 + 10));*/
+			}
+			if (cube.tileSide != -1)
+			{
+				quads.push_back(glm::vec3(10 * x, -cube.h3, 10 * gnd->height - 10 * y));
+				quads.push_back(glm::vec3(10 * x + 10, -cube.h4, 10 * gnd->height - 10 * y));
+				quads.push_back(glm::vec3(10 * x + 10, -gnd->cube(x, y + 1).h2, 10 * gnd->height - 10 * y));
+				quads.push_back(glm::vec3(10 * x, -gnd->cube(x, y + 1).h1, 10 * gnd->height - 10 * y));
+			}
+			if (cube.tileFront != -1)
+			{
+				quads.push_back(glm::vec3(10 * x + 10, -cube.h2, 10 * gnd->height - 10 * y + 10));
+				quads.push_back(glm::vec3(10 * x + 10, -cube.h4, 10 * gnd->height - 10 * y));
+				quads.push_back(glm::vec3(10 * x + 10, -gnd->cube(x + 1, y).h3, 10 * gnd->height - 10 * y));
+				quads.push_back(glm::vec3(10 * x + 10, -gnd->cube(x + 1, y).h1, 10 * gnd->height - 10 * y + 10));
+			}
+		}
+	}
+
+		/*for (int x = 0; x < gnd->width; x++)
+		{
+			for (int y = 0; y < gnd->height; y++)
+			{
+				if (gnd->cube(x, y).tileUp != -1)
+				{
+					file << "f ";
+					for (int i = 0; i < 4; i++)
+						file << (x + y * gnd->width) * 4 + i + 1 << " ";
+					file << std::endl;
+				}
+				if (gnd->cube(x, y).tileSide != -1)
+				{
+					file << "f ";
+					file << (x + y * gnd->width) * 4 + 2 + 1 << " ";
+					file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
+					file << (x + (y + 1) * gnd->width) * 4 + 0 + 1 << " ";
+					file << (x + (y + 1) * gnd->width) * 4 + 1 + 1 << " ";
+					file << std::endl;
+				}
+
+				if (gnd->cube(x, y).tileFront != -1)
+				{
+					file << "f ";
+					file << (x + y * gnd->width) * 4 + 3 + 1 << " ";
+					file << (x + y * gnd->width) * 4 + 0 + 1 << " ";
+					file << ((x + 1) + y * gnd->width) * 4 + 1 + 1 << " ";
+					file << ((x + 1) + y * gnd->width) * 4 + 2 + 1 << " ";
+					file << std::endl;
+				}
+			}
+		}*/
+	return quads;
+}
+
+glm::vec4 Map::getHeightsAt(int x, int y)
+{
+	assert(inMap(x, y));
+	float ret[4];
+
+	for (int i = 0; i < 4; i++)
+	{
+		int xx = i % 2;
+		int yy = i / 2;
+		if (inMap(x - xx, y - yy))
+			ret[i] = gnd->cube(x - xx, y - yy).heights[i];
+		else
+			ret[i] = gnd->cube(x, y).heights[0];
+	}
+	return glm::vec4(ret[0], ret[1], ret[2], ret[3]);
+}
+
+
+float Map::getHeightAt(float x, float y)
+{
+	int ix = (int)x;
+	int iy = (int)y;
+
+	if (!inMap(ix, iy))
+		return 0;
+
+	//TODO: use barycentric coordinats
+	Gnd::Cube c = gnd->cube(ix, iy);
+	return (c.h1 + c.h2 + c.h3 + c.h4) / 4.0f;
+}
+
+
+template class blib::BackgroundTask<int>;
+
@@ -1,58 +1,81 @@
-#pragma once
-
-
-#include <vector>
-#include <string>
-class Gnd;
-class Rsw;
-class Gat;
-
-#include "Gnd.h"
-
-class Map
-{
-	Gnd* gnd;
-	Rsw* rsw;
-	Gat* gat;
-
-	std::string fileName;
-public:
-	Map(const std::string &fileName);
-	Map(const std::string &fileName, int width, int height);
-	~Map();
-
-	inline Gnd* getGnd() const
-	{
-		return gnd;
-	}
-	inline Rsw* getRsw() const
-	{
-		return rsw;
-	}
-	inline Gat* getGat() const
-	{
-		return gat;
-	}
-
-	inline const std::string getFileName() const
-	{
-		return fileName;
-	}
-
-	void save(const std::string &filename);
-	bool inMap(int xx, int yy);
-	void saveHeightmap(const std::string &fileName);
-	void loadHeightmap(const std::string &fileName);
-	void exportLightmap(const std::string &fileName);
-	void exportObj(const std::string &fileName);
-
-	float heightImportMin;
-	float heightImportMax;
-	std::vector<std::vector<Gnd::Cube> > heightImportCubes;
-
-
-	std::vector<glm::vec3> getMapQuads();
-
-	glm::vec4 getHeightsAt(int x, int y);
-	float getHeightAt(float x, float y);
+#pragma once
+
+
+#include <vector>
+#include <string>
+#include <functional>
+class Gnd;
+class Rsw;
+class Gat;
+
+#include "Gnd.h"
+#include "BufferWriter.h"
+
+class Map
+{
+	Gnd* gnd;
+	Rsw* rsw;
+	Gat* gat;
+
+	std::string fileName;
+public:
+	//with deferModels, the map is usable before its models are loaded, see Rsw::loadModelsInBackground
+	Map(const std::string &fileName, bool deferModels = false);
+	Map(const std::string &fileName, int width, int height);
+	~Map();
+
+	inline Gnd* getGnd() const
+	{
+		return gnd;
+	}
+	inline Rsw* getRsw() const
+	{
+		return rsw;
+	}
+	inline Gat* getGat() const
+	{
+		return gat;
+	}
+
+	inline const std::string getFileName() const
+	{
+		return fileName;
+	}
+
+	//a copy of everything that gets saved, made on the main thread. The files are serialized and written from the copy,
+	//on another thread, so the map can be edited while it is being saved
+	class SaveState
+	{
+	public:
+		std::string fileName;
+		Gnd* gnd;
+		Gat* gat;
+		BufferWriter rsw;
+		BufferWriter extra;
+
+		SaveState() : gnd(NULL), gat(NULL) {}
+		~SaveState();
+		//progress goes from 0 to 1. Every file is replaced in one go, so a failed save leaves the old files intact
+		bool write(const std::function<void(float)> &progress = nullptr);
+		bool writeToGrf(const std::string &grfFile, const std::function<void(float)> &progress = nullptr);
+	};
+	SaveState* prepareSave(const std::string &filename);
+
+	void save(const std::string &filename);
+	bool saveToGrf(const std::string &grfFile);
+	bool inMap(int xx, int yy);
+	void saveHeightmap(const std::string &fileName);
+	void loadHeightmap(const std::string &fileName);
+	void exportLightmap(const std::string &fileName);
+	void exportObj(const std::string &fileName);
+
+	float heightImportMin;
+	float heightImportMax;
+	std::vector<std::vector<glm::vec4> > heightImportCubes; //h1, h2, h3, h4 per cube
+
+
+	std::vector<glm::vec3> getMapQuads();
+
+	glm::vec4 getHeightsAt(int x, int y);
+	float getHeightAt(float x, float y);
 };
\ No newline at end of file
@@ -1,212 +1,222 @@
-#pragma once
-
-#include <glm/glm.hpp>
-#include <blib/RenderState.h>
-#include <blib/gl/Vertex.h>
-#include <blib/gl/GlResizeRegister.h>
-#include <blib/math/Ray.h>
-#include <blib/util/Timer.h>
-#include <map>
-#include <vector>
-
-#include "Rsw.h"
-#include "Rsm.h"
-
-namespace blib { class ResourceManager; class Shader; class Renderer; class App; class Texture; class VBO; };
-class Map;
-class Gnd;
-class Rsw;
-class Rsm;
-
-#define CHUNKSIZE 16
-
-class VboIndex
-{
-public:
-	int texture;
-	int begin;
-	int count;
-	VboIndex(int texture, int begin, int count)
-	{
-		this->texture = texture;
-		this->begin = begin;
-		this->count = count;
-	}
-};
-
-class RsmMeshRenderInfo
-{
-public:
-	blib::VBO* vbo = nullptr;
-	std::vector<VboIndex> indices;
-	glm::mat4 matrix;
-	glm::mat4 matrixSub;
-};
-
-class RsmModelRenderInfo
-{
-public:
-	~RsmModelRenderInfo();
-	std::vector<blib::Texture*> textures;
-	blib::util::Timer timer;
-};
-
-class MapRenderer : public blib::gl::GlResizeRegister
-{
-public:
-	typedef blib::VertexP3T2T2T2N3 GndVertex;
-private:
-	int width;
-	int height;
-#pragma region GND
-	class GndChunk
-	{
-	public:
-
-
-		bool dirty;
-		bool rebuilding;
-		blib::VBO* vbo;
-		std::vector<VboIndex> vertIndices;
-
-		int x, y;
-
-
-		GndChunk(int x, int y, blib::ResourceManager* resourceManager);
-
-		void render(const Gnd* gnd, blib::App* app, blib::RenderState &gndRenderState, blib::Renderer* renderer);
-		void rebuild(const Gnd* gnd, blib::App* app, blib::Renderer* renderer);
-	};
-	//gnd
-	blib::RenderState gndRenderState;
-	class GndShaderAttributes
-	{
-	public:
-		enum
-		{
-			ProjectionMatrix,
-			ModelViewMatrix,
-			s_texture,
-			s_lighting,
-			s_tileColor,
-			lightAmbient,
-			lightDiffuse,
-			lightIntensity,
-			lightDirection,
-		};
-	};	
-	std::vector<std::vector<GndChunk*> > gndChunks;
-	blib::Texture* gndShadow;
-	blib::Texture* gndNoShadow;
-	blib::Texture* gndTileColorWhite;
-	blib::Texture* gndTileColors;
-	bool gndShadowDirty;
-	bool gndTileColorDirty;
-#pragma endregion
-#pragma region RSW
-public:
-	blib::RenderState rswRenderState;
-	class RswShaderAttributes
-	{
-	public:
-		enum
-		{
-			ProjectionMatrix,
-			CameraMatrix,
-			ModelMatrix,
-			ModelMatrix2,
-			s_texture,
-			highlightColor,
-			billboard,
-			lightAmbient,
-			lightDiffuse,
-			lightIntensity,
-			lightDirection,
-			shadeType,
-		};
-	};
-
-	blib::RenderState highlightRenderState;
-	enum class HighlightShaderUniforms
-	{
-		s_texture,
-		modelviewMatrix,
-		projectionMatrix,
-		normalMatrix,
-		diffuse,
-		color,
-		texMult,
-	};
-
-
-	blib::VBO* gndTextureGridVbo;	
-	blib::VBO* gndGridVbo;
-
-
-	blib::Texture* rswLightTexture;
-	blib::Texture* rswEffectTexture;
-	blib::Texture* rswSoundTexture;
-	glm::mat4 billboardMatrix;
-
-#pragma endregion
-
-	blib::VBO* gatVbo;
-	blib::Texture* gatTexture;
-
-	blib::ResourceManager* resourceManager;
-
-	const Map* map;
-	blib::App* app;
-	std::vector<blib::Texture*> waterTextures;
-
-
-public:
-	MapRenderer();
-	glm::mat4 cameraMatrix;
-	glm::mat4 projectionMatrix;
-	float orthoDistance;
-
-	bool drawShadows;
-	bool drawObjects;
-	bool drawLights;
-	bool drawEffects;
-	bool drawSounds;
-	bool drawTextureGrid;
-	bool drawObjectGrid;
-	bool drawQuadTree;
-	bool drawGat;
-
-	float fov;
-
-	blib::FBO* fbo;
-	glm::vec4 mouse3d;
-	blib::math::Ray mouseRay;
-
-
-	void init( blib::ResourceManager* resourceManager, blib::App* app );
-	void setMap(const Map* map);
-
-	void render(blib::Renderer* renderer, glm::vec2 mousePosition);
-	void renderGnd(blib::Renderer* renderer);
-	void renderRsw( blib::Renderer* renderer );
-	void renderGat(blib::Renderer* renderer);
-
-	void renderObjects(blib::Renderer* renderer, bool selected);
-
-	void renderModel(Rsw::Model* model, blib::Renderer* renderer);
-	void renderMesh(Rsm::Mesh* mesh, const glm::mat4 &matrix, RsmModelRenderInfo* modelInfo, blib::Renderer* renderer);
-
-	virtual void resizeGl(int width, int height, int offsetx, int offsety) override;
-	void setTileDirty(int xx, int yy);
-	void setAllDirty();
-	void setShadowDirty();
-	void setColorDirty() { gndTileColorDirty = true; }
-	void renderMeshFbo(Rsm* rsm, float rotation, blib::FBO* fbo, blib::Renderer* renderer);
-	void renderMesh(Rsm* rsm, const glm::mat4& matrix, blib::Renderer* renderer);
-	bool gndTextureGridDirty;
-	bool gndGridDirty;
-	bool gatDirty;
-
-
-	void updateWaterTextures();
-};
+#pragma once
+
+#include <glm/glm.hpp>
+#include <blib/RenderState.h>
+#include <blib/gl/Vertex.h>
+#include <blib/gl/GlResizeRegister.h>
+#include <blib/math/Ray.h>
+#include <blib/math/AABB.h>
+#include <blib/util/Timer.h>
+#include <map>
+#include <vector>
+
+#include "Rsw.h"
+#include "Rsm.h"
+
+namespace blib { class ResourceManager; class Shader; class Renderer; class App; class Texture; class VBO; };
+class Map;
+class Gnd;
+class Rsw;
+class Rsm;
+
+#define CHUNKSIZE 16
+
+class VboIndex
+{
+public:
+	int texture;
+	int begin;
+	int count;
+	VboIndex(int texture, int begin, int count)
+	{
+		this->texture = texture;
+		this->begin = begin;
+		this->count = count;
+	}
+};
+
+class RsmMeshRenderInfo
+{
+public:
+	~RsmMeshRenderInfo();
+	bool built = false; //the vbo is made when the mesh is first drawn, the matrices can be set before that
+	blib::VBO* vbo = nullptr;
+	std::vector<VboIndex> indices;
+	glm::mat4 matrix;
+	glm::mat4 matrixSub;
+};
+
+class RsmModelRenderInfo
+{
+public:
+	~RsmModelRenderInfo();
+	std::vector<blib::Texture*> textures;
+	blib::util::Timer timer;
+};
+
+class MapRenderer : public blib::gl::GlResizeRegister
+{
+public:
+	typedef blib::VertexP3T2T2T2N3 GndVertex;
+private:
+	int width;
+	int height;
+#pragma region GND
+	class GndChunk
+	{
+	public:
+
+
+		bool dirty;
+		bool rebuilding;
+		blib::VBO* vbo;
+		std::vector<VboIndex> vertIndices;
+
+		int x, y;
+		blib::math::AABB aabb; //world space bounds of the chunk, only valid once it is built
+
+
+		GndChunk(int x, int y, blib::ResourceManager* resourceManager);
+
+		void render(const Gnd* gnd, blib::App* app, blib::RenderState &gndRenderState, blib::Renderer* renderer);
+		void rebuild(const Gnd* gnd, blib::App* app, blib::Renderer* renderer);
+	};
+	//gnd
+	blib::RenderState gndRenderState;
+	class GndShaderAttributes
+	{
+	public:
+		enum
+		{
+			ProjectionMatrix,
+			ModelViewMatrix,
+			s_texture,
+			s_lighting,
+			s_tileColor,
+			lightAmbient,
+			lightDiffuse,
+			lightIntensity,
+			lightDirection,
+		};
+	};	
+	std::vector<std::vector<GndChunk*> > gndChunks;
+	blib::Texture* gndShadow;
+	blib::Texture* gndNoShadow;
+	blib::Texture* gndTileColorWhite;
+	blib::Texture* gndTileColors;
+	bool gndShadowDirty;
+	bool gndShadowBuilding; //the lightmap texture is being built in the background, from the lightmaps of the gnd
+	bool gndTileColorDirty;
+	glm::ivec4 gndNormalsDirty; //x1, y1, x2, y2 of the cubes that changed since the normals were last updated, empty when x1 > x2
+#pragma endregion
+#pragma region RSW
+public:
+	blib::RenderState rswRenderState;
+	class RswShaderAttributes
+	{
+	public:
+		enum
+		{
+			ProjectionMatrix,
+			CameraMatrix,
+			ModelMatrix,
+			ModelMatrix2,
+			s_texture,
+			highlightColor,
+			billboard,
+			lightAmbient,
+			lightDiffuse,
+			lightIntensity,
+			lightDirection,
+			shadeType,
+		};
+	};
+
+	blib::RenderState highlightRenderState;
+	enum class HighlightShaderUniforms
+	{
+		s_texture,
+		modelviewMatrix,
+		projectionMatrix,
+		normalMatrix,
+		diffuse,
+		color,
+		texMult,
+	};
+
+
+	blib::VBO* gndTextureGridVbo;	
+	blib::VBO* gndGridVbo;
+
+
+	blib::Texture* rswLightTexture;
+	blib::Texture* rswEffectTexture;
+	blib::Texture* rswSoundTexture;
+	glm::mat4 billboardMatrix;
+
+#pragma endregion
+
+	blib::VBO* gatVbo;
+	blib::Texture* gatTexture;
+
+	blib::ResourceManager* resourceManager;
+
+	const Map* map;
+	blib::App* app;
+	std::vector<blib::Texture*> waterTextures;
+
+
+public:
+	MapRenderer();
+	glm::mat4 cameraMatrix;
+	glm::mat4 projectionMatrix;
+	float orthoDistance;
+
+	bool drawShadows;
+	bool drawObjects;
+	bool drawLights;
+	bool drawEffects;
+	bool drawSounds;
+	bool drawTextureGrid;
+	bool drawObjectGrid;
+	bool drawQuadTree;
+	bool drawGat;
+
+	float fov;
+
+	int gndChunksDrawn; //gnd chunks drawn and skipped for being outside of the view in the last frame, shown in the status bar
+	int gndChunksCulled;
+
+	blib::FBO* fbo;
+	glm::vec4 mouse3d;
+	blib::math::Ray mouseRay;
+
+
+	void init( blib::ResourceManager* resourceManager, blib::App* app );
+	void setMap(const Map* map);
+
+	void render(blib::Renderer* renderer, glm::vec2 mousePosition);
+	void renderGnd(blib::Renderer* renderer);
+	void renderRsw( blib::Renderer* renderer );
+	void renderGat(blib::Renderer* renderer);
+
+	void renderObjects(blib::Renderer* renderer, bool selected);
+
+	void renderModel(Rsw::Model* model, blib::Renderer* renderer);
+	void renderMesh(Rsm::Mesh* mesh, const glm::mat4 &matrix, RsmModelRenderInfo* modelInfo, blib::Renderer* renderer);
+
+	virtual void resizeGl(int width, int height, int offsetx, int offsety) override;
+	void setTileDirty(int xx, int yy);
+	void setAllDirty();
+	void setShadowDirty();
+	bool isShadowBuilding() const;
+	void setColorDirty() { gndTileColorDirty = true; }
+	void renderMeshFbo(Rsm* rsm, float rotation, blib::FBO* fbo, blib::Renderer* renderer);
+	void renderMesh(Rsm* rsm, const glm::mat4& matrix, blib::Renderer* renderer);
+	bool gndTextureGridDirty;
+	bool gndGridDirty;
+	bool gatDirty;
+
+
+	void updateWaterTextures();
+};
@@ -0,0 +1,269 @@
+#include "OverlayFileSystemHandler.h"
+#include "GrfFileSystemHandler.h"
+#include <blib/util/Log.h>
+using blib::util::Log;
+
+#include <algorithm>
+#include <cstring>
+#include <sys/stat.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+
+std::vector<OverlayFileSystemHandler*> OverlayFileSystemHandler::instances;
+
+OverlayFileSystemHandler::OverlayFileSystemHandler() : blib::util::FileSystemHandler("Overlay")
+{
+	tableMask = 0;
+	instances.push_back(this);
+}
+
+OverlayFileSystemHandler::~OverlayFileSystemHandler()
+{
+	instances.erase(std::remove(instances.begin(), instances.end(), this), instances.end());
+	for (Source &source : sources)
+	{
+		delete source.grf;
+		delete source.physical;
+	}
+}
+
+void OverlayFileSystemHandler::addGrf(GrfFileSystemHandler* grf)
+{
+	Source source;
+	source.grf = grf;
+	source.physical = NULL;
+	sources.push_back(source);
+}
+
+void OverlayFileSystemHandler::addDirectory(const std::string &directory)
+{
+	Source source;
+	source.grf = NULL;
+	source.physical = new blib::util::PhysicalFileSystemHandler(directory);
+	source.directory = directory;
+	scanDirectory(source, directory, "data");
+	sources.push_back(source);
+}
+
+void OverlayFileSystemHandler::scanDirectory(Source &source, const std::string &root, const std::string &directory)
+{
+#ifdef WIN32
+	WIN32_FIND_DATAA data;
+	HANDLE handle = FindFirstFileA((root + "/" + directory + "/*").c_str(), &data);
+	if (handle == INVALID_HANDLE_VALUE)
+		return;
+	do
+	{
+		std::string name = data.cFileName;
+		if (name == "." || name == "..")
+			continue;
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			scanDirectory(source, root, directory + "/" + name);
+		else
+			source.files.push_back(directory + "/" + name);
+	} while (FindNextFileA(handle, &data));
+	FindClose(handle);
+#else
+	DIR* dir = opendir((root + "/" + directory).c_str());
+	if (!dir)
+		return;
+	while (dirent* entry = readdir(dir))
+	{
+		std::string name = entry->d_name;
+		if (name == "." || name == "..")
+			continue;
+		struct stat info;
+		if (stat((root + "/" + directory + "/" + name).c_str(), &info) != 0)
+			continue;
+		if (S_ISDIR(info.st_mode))
+			scanDirectory(source, root, directory + "/" + name);
+		else
+			source.files.push_back(directory + "/" + name);
+	}
+	closedir(dir);
+#endif
+}
+
+
+const char* OverlayFileSystemHandler::getName(const HashSlot &slot) const
+{
+	const Source &source = sources[slot.source];
+	if (source.grf)
+		return source.grf->getFileName(slot.index);
+	return source.files[slot.index].c_str();
+}
+
+int OverlayFileSystemHandler::find(const char* fileName, uint32_t hash) const
+{
+	for (uint32_t i = hash & tableMask; table[i].source != -1; i = (i + 1) & tableMask)
+		if (table[i].hash == hash && GrfFileSystemHandler::equalFileNames(fileName, getName(table[i])))
+			return i;
+	return -1;
+}
+
+//adds a file to the index, unless a source with a higher priority already has it
+void OverlayFileSystemHandler::insert(int source, int index, const char* fileName)
+{
+	uint32_t hash = GrfFileSystemHandler::hashFileName(fileName);
+	uint32_t slot = hash & tableMask;
+	while (table[slot].source != -1)
+	{
+		if (table[slot].hash == hash && GrfFileSystemHandler::equalFileNames(fileName, getName(table[slot])))
+		{
+			if (table[slot].source == source) //within a grf, later entries override earlier ones
+				table[slot].index = index;
+			return;
+		}
+		slot = (slot + 1) & tableMask;
+	}
+	table[slot] = HashSlot{ hash, source, index };
+	fileNames.push_back(GrfFileSystemHandler::sanitizeFileName(fileName));
+}
+
+void OverlayFileSystemHandler::buildIndex()
+{
+	size_t count = 0;
+	for (const Source &source : sources)
+		count += source.grf ? source.grf->getFileCount() : source.files.size();
+
+	unsigned int tableSize = 16;
+	while (tableSize < count * 2)
+		tableSize *= 2;
+	tableMask = tableSize - 1;
+	table.assign(tableSize, HashSlot{ 0, -1, 0 });
+	fileNames.clear();
+	fileNames.reserve(count);
+
+	for (size_t i = 0; i < sources.size(); i++)
+	{
+		if (sources[i].grf)
+			for (unsigned int ii = 0; ii < sources[i].grf->getFileCount(); ii++)
+				insert((int)i, ii, sources[i].grf->getFileName(ii));
+		else
+			for (size_t ii = 0; ii < sources[i].files.size(); ii++)
+				insert((int)i, (int)ii, sources[i].files[ii].c_str());
+	}
+	std::sort(fileNames.begin(), fileNames.end());
+	Log::out << "Resource index: " << fileNames.size() << " files from " << sources.size() << " sources" << Log::newline;
+}
+
+
+blib::util::StreamInFile* OverlayFileSystemHandler::openRead(const std::string &fileName)
+{
+	if (!table.empty())
+	{
+		int slot = find(fileName.c_str(), GrfFileSystemHandler::hashFileName(fileName.c_str()));
+		if (slot != -1)
+		{
+			const Source &source = sources[table[slot].source];
+			if (source.grf)
+				return source.grf->openRead(table[slot].index);
+			return source.physical->openRead(source.files[table[slot].index]);
+		}
+	}
+
+	//files that aren't in the index are passed on to the directories as is. Only their data folder is indexed, and only
+	//when the index is built, so files added to it while the editor runs are found here too
+	for (const Source &source : sources)
+	{
+		if (!source.physical)
+			continue;
+		blib::util::StreamInFile* file = source.physical->openRead(fileName);
+		if (file)
+			return file;
+	}
+	return NULL;
+}
+
+//files found in a grf are handed to that grf to be extracted ahead of time, files in directories are left alone
+void OverlayFileSystemHandler::prefetch(const std::vector<std::string> &fileNames)
+{
+	if (table.empty())
+		return;
+	std::vector<std::vector<int>> indices(sources.size());
+	for (const std::string &fileName : fileNames)
+	{
+		int slot = find(fileName.c_str(), GrfFileSystemHandler::hashFileName(fileName.c_str()));
+		if (slot != -1 && sources[table[slot].source].grf)
+			indices[table[slot].source].push_back(table[slot].index);
+	}
+	for (size_t i = 0; i < sources.size(); i++)
+		if (!indices[i].empty())
+			sources[i].grf->prefetch(indices[i]);
+}
+
+bool OverlayFileSystemHandler::statFile(std::string path, uint64_t &size, int64_t &modified)
+{
+	std::replace(path.begin(), path.end(), '\\', '/');
+#ifdef WIN32
+	struct __stat64 info;
+	if (_stat64(path.c_str(), &info) != 0)
+#else
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+#endif
+		return false;
+	size = info.st_size;
+	modified = info.st_mtime;
+	return true;
+}
+
+//resolves the file the same way openRead does
+bool OverlayFileSystemHandler::getFileStamp(const std::string &fileName, uint64_t &size, int64_t &modified)
+{
+	if (!table.empty())
+	{
+		int slot = find(fileName.c_str(), GrfFileSystemHandler::hashFileName(fileName.c_str()));
+		if (slot != -1)
+		{
+			const Source &source = sources[table[slot].source];
+			if (source.grf)
+			{
+				source.grf->getFileStamp(table[slot].index, size, modified);
+				return true;
+			}
+			return statFile(source.directory + "/" + source.files[table[slot].index], size, modified);
+		}
+	}
+	for (const Source &source : sources)
+		if (source.physical && statFile(source.directory + "/" + fileName, size, modified))
+			return true;
+	return false;
+}
+
+bool OverlayFileSystemHandler::getFileStampAll(const std::string &fileName, uint64_t &size, int64_t &modified)
+{
+	for (OverlayFileSystemHandler* handler : instances)
+		if (handler->getFileStamp(fileName, size, modified))
+			return true;
+	return false;
+}
+
+void OverlayFileSystemHandler::prefetchAll(const std::vector<std::string> &fileNames)
+{
+	for (OverlayFileSystemHandler* handler : instances)
+		handler->prefetch(fileNames);
+}
+
+void OverlayFileSystemHandler::getFileList(const std::string &path, std::vector<std::string> &files)
+{
+	std::string directory = GrfFileSystemHandler::sanitizeFileName(path);
+	for (auto it = std::lower_bound(fileNames.begin(), fileNames.end(), directory); it != fileNames.end() && it->compare(0, directory.size(), directory) == 0; it++)
+	{
+		if (it->find("\\", directory.size() + 1) == std::string::npos)
+			files.push_back(*it);
+	}
+}
+
+void OverlayFileSystemHandler::getFileList(const std::function<bool(const std::string&)> &filter, std::vector<std::string> &files)
+{
+	for (const std::string &fileName : fileNames)
+	{
+		if (filter(fileName))
+			files.push_back(fileName);
+	}
+}
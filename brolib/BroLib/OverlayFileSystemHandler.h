@@ -0,0 +1,64 @@
+#pragma once
+
+#include <blib/util/FileSystem.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class GrfFileSystemHandler;
+
+//serves the files of several grfs and data directories from one index. Sources are added in priority order,
+//when a file exists in multiple sources, the first source it was found in wins
+class OverlayFileSystemHandler : public blib::util::FileSystemHandler
+{
+	class Source
+	{
+	public:
+		GrfFileSystemHandler* grf;
+		blib::util::PhysicalFileSystemHandler* physical;
+		std::string directory;
+		std::vector<std::string> files; //names of the files in a directory source, relative to the directory
+	};
+
+	class HashSlot
+	{
+	public:
+		uint32_t hash;
+		int source; //-1 for an empty slot
+		int index; //index of the file in the grf, or in Source::files
+	};
+
+	std::vector<Source> sources;
+	std::vector<HashSlot> table;
+	uint32_t tableMask;
+	std::vector<std::string> fileNames; //sanitized and sorted, for getFileList
+
+	static std::vector<OverlayFileSystemHandler*> instances;
+
+	const char* getName(const HashSlot &slot) const;
+	int find(const char* fileName, uint32_t hash) const;
+	void insert(int source, int index, const char* fileName);
+	void scanDirectory(Source &source, const std::string &root, const std::string &directory);
+public:
+	OverlayFileSystemHandler();
+	~OverlayFileSystemHandler();
+
+	void addGrf(GrfFileSystemHandler* grf);
+	void addDirectory(const std::string &directory);
+	void buildIndex();
+	void prefetch(const std::vector<std::string> &fileNames);
+	//size and modification time of the file a name resolves to, so a caller can tell if it changed without reading it.
+	//Files in a grf get the modification time of the grf
+	bool getFileStamp(const std::string &fileName, uint64_t &size, int64_t &modified);
+
+	//prefetches files on all overlay handlers, so the set of files a map needs can be pulled in at once
+	static void prefetchAll(const std::vector<std::string> &fileNames);
+	static bool getFileStampAll(const std::string &fileName, uint64_t &size, int64_t &modified);
+	//size and modification time of a file on disk, the same as getFileStamp gives for the files in a directory
+	static bool statFile(std::string path, uint64_t &size, int64_t &modified);
+
+	virtual blib::util::StreamInFile* openRead(const std::string &fileName);
+	virtual void getFileList(const std::string &path, std::vector<std::string> &files);
+	virtual void getFileList(const std::function<bool(const std::string&)> &filter, std::vector<std::string> &files);
+};
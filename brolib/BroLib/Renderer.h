@@ -1,13 +1,13 @@
-#pragma once
-
-namespace blib
-{
-	class Renderer;
-}
-
-class Renderer
-{
-public:
-	virtual void render(blib::Renderer* renderer) = 0;
-
+#pragma once
+
+namespace blib
+{
+	class Renderer;
+}
+
+class Renderer
+{
+public:
+	virtual void render(blib::Renderer* renderer) = 0;
+
 };
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "RsmCache.h"
+#include "Rsm.h"
+#include "GrfFileSystemHandler.h"
+#include <blib/util/Log.h>
+using blib::util::Log;
+
+
+RsmCache::RsmCache()
+{
+	cacheSize = 0;
+	cacheBudget = 128 * 1024 * 1024;
+	cacheHits = 0;
+	cacheMisses = 0;
+	cacheEvictedBytes = 0;
+}
+
+//the cache is never destroyed, the models in it hold gpu buffers that can't be freed after the renderer is gone
+RsmCache& RsmCache::getInstance()
+{
+	static RsmCache* instance = new RsmCache();
+	return *instance;
+}
+
+//rough size of a model: the mesh data, and the vertex buffers that are made out of the faces when it is rendered
+static size_t modelSize(Rsm* rsm)
+{
+	size_t size = sizeof(Rsm);
+	rsm->rootMesh->foreach([&size](Rsm::Mesh* mesh)
+	{
+		size += sizeof(Rsm::Mesh);
+		size += mesh->vertices.size() * sizeof(glm::vec3);
+		size += mesh->texCoords.size() * sizeof(glm::vec2);
+		size += mesh->faces.size() * (sizeof(Rsm::Mesh::Face) + 3 * 8 * sizeof(float));
+		size += mesh->frames.size() * sizeof(Rsm::Mesh::Frame);
+	});
+	return size;
+}
+
+//models are looked up on their sanitized name, so the names in rsw files and in the grf file list find the same model
+Rsm* RsmCache::get(const std::string &fileName)
+{
+	std::string key = GrfFileSystemHandler::sanitizeFileName(fileName);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto cached = cacheLookup.find(key);
+		if (cached != cacheLookup.end())
+		{
+			cacheHits++;
+			cache.splice(cache.begin(), cache, cached->second);
+			cache.front().refs++;
+			return cache.front().rsm;
+		}
+	}
+
+	//load without holding the lock, so several models can load at the same time
+	Rsm* rsm = new Rsm(fileName);
+	if (!rsm->loaded)
+	{
+		delete rsm;
+		return NULL;
+	}
+	size_t size = modelSize(rsm);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	cacheMisses++;
+	auto cached = cacheLookup.find(key);
+	if (cached != cacheLookup.end()) //another thread loaded the same model in the meantime. Ours isn't rendered yet, so it can be deleted here
+	{
+		delete rsm;
+		cache.splice(cache.begin(), cache, cached->second);
+		cache.front().refs++;
+		return cache.front().rsm;
+	}
+	cache.push_front(CacheEntry{ key, rsm, size, 1 });
+	cacheLookup[key] = cache.begin();
+	cacheSize += size;
+	return rsm;
+}
+
+void RsmCache::release(Rsm* rsm, bool allowEvict)
+{
+	if (!rsm)
+		return;
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = cacheLookup.find(GrfFileSystemHandler::sanitizeFileName(rsm->fileName));
+	if (it == cacheLookup.end() || it->second->rsm != rsm)
+	{
+		Log::err << "RsmCache: releasing a model that isn't in the cache: " << rsm->fileName << Log::newline;
+		return;
+	}
+	it->second->refs--;
+	if (allowEvict)
+		evict();
+}
+
+void RsmCache::setBudget(size_t budget)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	cacheBudget = budget;
+	evict();
+}
+
+void RsmCache::logStats()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Log::out << "Model cache: " << cacheHits << " hits, " << cacheMisses << " misses, " << (cacheEvictedBytes / 1024) << "kb evicted, " << cache.size() << " models, " << (cacheSize / 1024) << "kb in use" << Log::newline;
+}
+
+//drops the least recently used models that aren't referenced until the cache fits its budget again. Needs the mutex to be locked
+void RsmCache::evict()
+{
+	auto it = cache.end();
+	while (cacheSize > cacheBudget && it != cache.begin())
+	{
+		--it;
+		if (it->refs > 0)
+			continue;
+		delete it->rsm;
+		cacheSize -= it->size;
+		cacheEvictedBytes += it->size;
+		cacheLookup.erase(it->fileName);
+		it = cache.erase(it);
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <list>
+#include <map>
+#include <mutex>
+
+class Rsm;
+
+//process wide cache of loaded models, shared by all maps and the object browser, so a model is only parsed and uploaded once.
+//Models are reference counted. Models that aren't referenced anymore stay in the cache until it goes over its budget,
+//then the least recently used ones are dropped
+class RsmCache
+{
+	class CacheEntry
+	{
+	public:
+		std::string fileName; //sanitized
+		Rsm* rsm;
+		size_t size;
+		int refs;
+	};
+
+	std::mutex mutex;
+	std::list<CacheEntry> cache; //most recently used entry at the front, the entries own their model
+	std::map<std::string, std::list<CacheEntry>::iterator> cacheLookup;
+	size_t cacheSize;
+	size_t cacheBudget;
+
+	size_t cacheHits;
+	size_t cacheMisses;
+	size_t cacheEvictedBytes;
+
+	RsmCache();
+	void evict();
+public:
+	static RsmCache& getInstance();
+
+	//loads a model, or gets it from the cache, and adds a reference to it. Returns NULL if the model can't be loaded.
+	//Can be called from several threads at once
+	Rsm* get(const std::string &fileName);
+	//drops a reference. Unreferenced models can be evicted, which frees their gpu buffers, so only the main thread should allow evicting.
+	//Other threads pass false, and the model is evicted later on, when the main thread releases something
+	void release(Rsm* rsm, bool allowEvict = true);
+
+	void setBudget(size_t budget);
+	void logStats();
+};
@@ -0,0 +1,340 @@
+#include "WorkspaceCache.h"
+#include "Gnd.h"
+#include "Gat.h"
+#include "BufferReader.h"
+#include "GrfFileSystemHandler.h"
+#include "OverlayFileSystemHandler.h"
+
+#include <blib/util/FileSystem.h>
+#include <blib/util/Log.h>
+using blib::util::Log;
+
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <cctype>
+#include <sys/stat.h>
+#ifdef WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const char WorkspaceCache::magic[8] = { 'B', 'R', 'O', 'W', 'S', 'P', 'C', 'E' };
+std::string WorkspaceCache::directory;
+
+
+//maps are opened as data/<map>, but saved under whatever path the save dialog gave, which can be absolute. The cache
+//is keyed on the part from the data directory on, so a map finds its cache no matter how it was saved
+std::string WorkspaceCache::getMapName(const std::string &fileName)
+{
+	std::string name = fileName;
+	std::replace(name.begin(), name.end(), '\\', '/');
+	std::transform(name.begin(), name.end(), name.begin(), [](char c) { return (char)tolower((unsigned char)c); });
+	size_t data = name.rfind("/data/");
+	if (data != std::string::npos)
+		name = name.substr(data + 1);
+	return name;
+}
+
+//the cache file is named after the hash of the map name; the full name is stored inside to catch collisions
+std::string WorkspaceCache::getCacheFile(const std::string &mapName)
+{
+	char hash[16];
+	sprintf(hash, "%08x", GrfFileSystemHandler::hashFileName(mapName.c_str()));
+	return directory + "/" + hash + ".bromap";
+}
+
+//64 bit fnv-1a, taken 8 bytes at a time
+uint64_t WorkspaceCache::hashData(const char* data, size_t size)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t word;
+		memcpy(&word, data + i, 8);
+		hash ^= word;
+		hash *= 0x100000001b3ULL;
+	}
+	for (; i < size; i++)
+	{
+		hash ^= (unsigned char)data[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+bool WorkspaceCache::hashFile(const std::string &fileName, uint64_t &hash)
+{
+	blib::util::StreamInFile* file = blib::util::FileSystem::openRead(fileName);
+	if (!file || !file->opened())
+	{
+		delete file;
+		return false;
+	}
+	std::vector<char> buffer;
+	BufferReader::readAll(file, buffer);
+	delete file;
+	hash = hashData(buffer.data(), buffer.size());
+	return true;
+}
+
+static inline uint32_t align8(uint32_t offset)
+{
+	return (offset + 7) & ~7;
+}
+
+bool WorkspaceCache::load(const std::string &fileName, Gnd* &gnd, Gat* &gat)
+{
+	if (directory.empty())
+		return false;
+	std::string mapName = getMapName(fileName);
+	std::string cacheFile = getCacheFile(mapName);
+
+	size_t size = 0;
+#ifdef WIN32
+	HANDLE file = CreateFileA(cacheFile.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	size = GetFileSize(file, NULL);
+	HANDLE mapping = size >= sizeof(Header) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+	const char* data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+#else
+	int file = open(cacheFile.c_str(), O_RDONLY);
+	if (file == -1)
+		return false;
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size < (off_t)sizeof(Header))
+	{
+		close(file);
+		return false;
+	}
+	size = info.st_size;
+	void* map = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (map == MAP_FAILED)
+		return false;
+	const char* data = (const char*)map;
+#endif
+
+	const Header* header = (const Header*)data;
+	auto fits = [size](uint32_t offset, uint64_t count, size_t recordSize) { return offset <= size && count * recordSize <= size - offset; };
+	uint64_t cubes = (uint64_t)(uint32_t)header->width * (uint32_t)header->height;
+	uint64_t gatTileCount = (uint64_t)(uint32_t)header->gatWidth * (uint32_t)header->gatHeight;
+	//the files are only hashed when their size or modification time changed since the cache was written. Hashing costs more
+	//than the rest of loading the cache, and would make a cache hit slower than parsing the map
+	uint64_t gndSize = 0, gatSize = 0;
+	int64_t gndTime = 0, gatTime = 0;
+	bool stamped = OverlayFileSystemHandler::getFileStampAll(fileName + ".gnd", gndSize, gndTime) &&
+		OverlayFileSystemHandler::getFileStampAll(fileName + ".gat", gatSize, gatTime);
+	bool unchanged = stamped && gndSize == header->gndSize && gndTime == header->gndTime && gatSize == header->gatSize && gatTime == header->gatTime;
+	uint64_t gndHash = 0, gatHash = 0;
+	bool valid = memcmp(header->magic, magic, sizeof(magic)) == 0 && header->version == version && header->size == size &&
+		header->tileSize == sizeof(Gnd::Tile) && header->width >= 0 && header->height >= 0 && header->gatWidth >= 0 && header->gatHeight >= 0 &&
+		header->nameOffset < size && data[size - 1] == 0 && mapName == data + header->nameOffset &&
+		fits(header->texturesOffset, header->textureCount, 80) &&
+		fits(header->lightmapsOffset, header->lightmapCount, sizeof(Gnd::Lightmap)) &&
+		fits(header->tilesOffset, header->tileCount, sizeof(Gnd::Tile)) &&
+		fits(header->heightsOffset, cubes, 4 * sizeof(float)) &&
+		fits(header->tileIdsOffset, cubes, 3 * sizeof(int)) &&
+		fits(header->normalsOffset, cubes, sizeof(glm::vec3)) &&
+		fits(header->cornerNormalsOffset, cubes, 4 * sizeof(glm::vec3)) &&
+		fits(header->gatTilesOffset, gatTileCount, sizeof(Gat::Tile)) &&
+		(unchanged || (hashFile(fileName + ".gnd", gndHash) && gndHash == header->gndHash &&
+			hashFile(fileName + ".gat", gatHash) && gatHash == header->gatHash));
+
+	if (valid)
+	{
+		//the arrays are copied straight out of the mapped file, without filling them first
+		gnd = new Gnd(0, 0);
+		gnd->version = (short)header->gndVersion;
+		gnd->width = header->width;
+		gnd->height = header->height;
+		gnd->tileScale = header->tileScale;
+		gnd->maxTexName = header->maxTexName;
+		gnd->lightmapWidth = header->lightmapWidth;
+		gnd->lightmapHeight = header->lightmapHeight;
+		gnd->gridSizeCell = header->gridSizeCell;
+		BufferReader textures(data + header->texturesOffset, header->textureCount * 80);
+		gnd->textures.reserve(header->textureCount);
+		for (uint32_t i = 0; i < header->textureCount; i++)
+		{
+			Gnd::Texture* texture = new Gnd::Texture();
+			texture->file = textures.readString(40);
+			texture->name = textures.readString(40);
+			gnd->textures.push_back(texture);
+		}
+		const Gnd::Lightmap* lightmaps = (const Gnd::Lightmap*)(data + header->lightmapsOffset);
+		gnd->lightmaps.assign(lightmaps, lightmaps + header->lightmapCount);
+		const Gnd::Tile* tiles = (const Gnd::Tile*)(data + header->tilesOffset);
+		gnd->tiles.assign(tiles, tiles + header->tileCount);
+		gnd->sweptTileCount = gnd->tiles.size();
+		const float* heights = (const float*)(data + header->heightsOffset);
+		gnd->cubeHeights.assign(heights, heights + 4 * cubes);
+		const int* tileIds = (const int*)(data + header->tileIdsOffset);
+		gnd->cubeTileIds.assign(tileIds, tileIds + 3 * cubes);
+		const glm::vec3* normals = (const glm::vec3*)(data + header->normalsOffset);
+		gnd->cubeNormals.assign(normals, normals + cubes);
+		const glm::vec3* cornerNormals = (const glm::vec3*)(data + header->cornerNormalsOffset);
+		gnd->cubeCornerNormals.assign(cornerNormals, cornerNormals + 4 * cubes);
+		gnd->cubeSelection.assign(cubes, false);
+
+		gat = new Gat(0, 0);
+		gat->version = header->gatVersion;
+		gat->width = header->gatWidth;
+		gat->height = header->gatHeight;
+		const Gat::Tile* gatTiles = (const Gat::Tile*)(data + header->gatTilesOffset);
+		gat->tiles.assign(gatTiles, gatTiles + gatTileCount);
+		gat->tileSelection.assign(gatTileCount, false);
+	}
+
+#ifdef WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mapping);
+#else
+	munmap(map, size);
+#endif
+
+	//the files were touched without changing, the new stamps are stored so they aren't hashed again next time
+	if (valid && stamped && !unchanged)
+	{
+		int64_t stamps[4] = { (int64_t)gndSize, gndTime, (int64_t)gatSize, gatTime }; //laid out as in the header
+		FILE* file = fopen(cacheFile.c_str(), "r+b");
+		if (file)
+		{
+			if (fseek(file, offsetof(Header, gndSize), SEEK_SET) == 0)
+				fwrite(stamps, sizeof(stamps), 1, file);
+			fclose(file);
+		}
+	}
+	return valid;
+}
+
+//writes the cache for a map that was just loaded, so the gnd and gat match the files it was loaded from
+void WorkspaceCache::save(const std::string &fileName, const Gnd* gnd, const Gat* gat)
+{
+	if (directory.empty() || gnd->width == 0 || gat->width == 0)
+		return;
+
+	Header header;
+	memset(&header, 0, sizeof(Header));
+	if (!hashFile(fileName + ".gnd", header.gndHash) || !hashFile(fileName + ".gat", header.gatHash))
+		return;
+	//without stamps, the files are hashed every time the cache is loaded
+	if (!OverlayFileSystemHandler::getFileStampAll(fileName + ".gnd", header.gndSize, header.gndTime) ||
+		!OverlayFileSystemHandler::getFileStampAll(fileName + ".gat", header.gatSize, header.gatTime))
+		header.gndSize = header.gndTime = header.gatSize = header.gatTime = 0;
+	writeCache(getMapName(fileName), gnd, gat, header);
+}
+
+//writes the cache for a map that was just saved to fileName. The hashes are taken from the data that was written, and the
+//stamps from the files on disk, instead of whatever the name resolves to in the grfs and the ro directory
+void WorkspaceCache::saveWritten(const std::string &fileName, const Gnd* gnd, const Gat* gat, const std::vector<char> &gndData, const std::vector<char> &gatData)
+{
+	if (directory.empty() || gnd->width == 0 || gat->width == 0)
+		return;
+
+	Header header;
+	memset(&header, 0, sizeof(Header));
+	header.gndHash = hashData(gndData.data(), gndData.size());
+	header.gatHash = hashData(gatData.data(), gatData.size());
+	if (!OverlayFileSystemHandler::statFile(fileName + ".gnd", header.gndSize, header.gndTime) ||
+		!OverlayFileSystemHandler::statFile(fileName + ".gat", header.gatSize, header.gatTime))
+		header.gndSize = header.gndTime = header.gatSize = header.gatTime = 0;
+	writeCache(getMapName(fileName), gnd, gat, header);
+}
+
+//fills in the rest of the header, and writes the cache. The hashes and stamps are set by the caller
+void WorkspaceCache::writeCache(const std::string &mapName, const Gnd* gnd, const Gat* gat, Header &header)
+{
+	memcpy(header.magic, magic, sizeof(header.magic));
+	header.version = version;
+
+	uint32_t cubes = gnd->width * gnd->height;
+	header.gndVersion = gnd->version;
+	header.width = gnd->width;
+	header.height = gnd->height;
+	header.tileScale = gnd->tileScale;
+	header.maxTexName = gnd->maxTexName;
+	header.lightmapWidth = gnd->lightmapWidth;
+	header.lightmapHeight = gnd->lightmapHeight;
+	header.gridSizeCell = gnd->gridSizeCell;
+	header.tileSize = sizeof(Gnd::Tile);
+	header.textureCount = (uint32_t)gnd->textures.size();
+	header.lightmapCount = (uint32_t)gnd->lightmaps.size();
+	header.tileCount = (uint32_t)gnd->tiles.size();
+	header.gatVersion = gat->version;
+	header.gatWidth = gat->width;
+	header.gatHeight = gat->height;
+
+	header.nameOffset = align8(sizeof(Header));
+	header.texturesOffset = align8(header.nameOffset + (uint32_t)mapName.size() + 1);
+	header.lightmapsOffset = align8(header.texturesOffset + header.textureCount * 80);
+	header.tilesOffset = align8(header.lightmapsOffset + header.lightmapCount * sizeof(Gnd::Lightmap));
+	header.heightsOffset = align8(header.tilesOffset + header.tileCount * sizeof(Gnd::Tile));
+	header.tileIdsOffset = align8(header.heightsOffset + cubes * 4 * sizeof(float));
+	header.normalsOffset = align8(header.tileIdsOffset + cubes * 3 * sizeof(int));
+	header.cornerNormalsOffset = align8(header.normalsOffset + cubes * sizeof(glm::vec3));
+	header.gatTilesOffset = align8(header.cornerNormalsOffset + cubes * 4 * sizeof(glm::vec3));
+	//the file ends with a zero, so the name is always terminated
+	header.size = header.gatTilesOffset + (uint32_t)(gat->tiles.size() * sizeof(Gat::Tile)) + 1;
+
+	std::vector<char> data(header.size, 0);
+	memcpy(&data[0], &header, sizeof(Header));
+	memcpy(&data[header.nameOffset], mapName.c_str(), mapName.size());
+	for (size_t i = 0; i < gnd->textures.size(); i++)
+	{
+		memcpy(&data[header.texturesOffset + 80 * i], gnd->textures[i]->file.c_str(), std::min(gnd->textures[i]->file.size(), (size_t)40));
+		memcpy(&data[header.texturesOffset + 80 * i + 40], gnd->textures[i]->name.c_str(), std::min(gnd->textures[i]->name.size(), (size_t)40));
+	}
+	if (!gnd->lightmaps.empty())
+		memcpy(&data[header.lightmapsOffset], gnd->lightmaps.data(), gnd->lightmaps.size() * sizeof(Gnd::Lightmap));
+	if (!gnd->tiles.empty())
+		memcpy(&data[header.tilesOffset], (const void*)gnd->tiles.data(), gnd->tiles.size() * sizeof(Gnd::Tile));
+	if (cubes > 0)
+	{
+		memcpy(&data[header.heightsOffset], gnd->cubeHeights.data(), cubes * 4 * sizeof(float));
+		memcpy(&data[header.tileIdsOffset], gnd->cubeTileIds.data(), cubes * 3 * sizeof(int));
+		memcpy(&data[header.normalsOffset], (const void*)gnd->cubeNormals.data(), cubes * sizeof(glm::vec3));
+		memcpy(&data[header.cornerNormalsOffset], (const void*)gnd->cubeCornerNormals.data(), cubes * 4 * sizeof(glm::vec3));
+	}
+	if (!gat->tiles.empty())
+		memcpy(&data[header.gatTilesOffset], gat->tiles.data(), gat->tiles.size() * sizeof(Gat::Tile));
+
+#ifdef WIN32
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+	//written to a temporary file first, so a crash halfway doesn't leave a broken cache behind
+	std::string cacheFile = getCacheFile(mapName);
+	std::string tmpFile = cacheFile + ".tmp";
+	FILE* file = fopen(tmpFile.c_str(), "wb");
+	if (!file)
+	{
+		Log::err << "Unable to write workspace cache " << cacheFile << Log::newline;
+		return;
+	}
+	bool ok = fwrite(&data[0], data.size(), 1, file) == 1;
+	ok = fclose(file) == 0 && ok;
+	std::remove(cacheFile.c_str());
+	if (!ok || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+	{
+		std::remove(tmpFile.c_str());
+		Log::err << "Unable to write workspace cache " << cacheFile << Log::newline;
+	}
+}
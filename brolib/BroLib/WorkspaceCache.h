@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class Gnd;
+class Gat;
+
+//binary cache of the parsed gnd and gat of a map, laid out the same as they are in memory, with the normals already calculated.
+//Reopening a map maps the cache and copies the arrays straight into place. The cache is only used when the gnd and gat files
+//it was made from have the same size and modification time as they have now, or when that changed, the same hash. Otherwise
+//the map is parsed as usual
+class WorkspaceCache
+{
+	class Header
+	{
+	public:
+		char magic[8];
+		uint32_t version;
+		uint32_t size;
+		uint64_t gndHash;
+		uint64_t gatHash;
+		uint64_t gndSize; //size and modification time of the files, checked before the hashes
+		int64_t gndTime;
+		uint64_t gatSize;
+		int64_t gatTime;
+		uint32_t nameOffset; //name of the map, to catch collisions of the cache file names
+
+		int32_t gndVersion;
+		int32_t width;
+		int32_t height;
+		float tileScale;
+		int32_t maxTexName;
+		int32_t lightmapWidth;
+		int32_t lightmapHeight;
+		int32_t gridSizeCell;
+		uint32_t tileSize; //size of a Gnd::Tile when the cache was written
+		uint32_t textureCount;
+		uint32_t lightmapCount;
+		uint32_t tileCount;
+		uint32_t texturesOffset; //file and name of each texture, 40 bytes each
+		uint32_t lightmapsOffset;
+		uint32_t tilesOffset;
+		uint32_t heightsOffset;
+		uint32_t tileIdsOffset;
+		uint32_t normalsOffset;
+		uint32_t cornerNormalsOffset;
+
+		int32_t gatVersion;
+		int32_t gatWidth;
+		int32_t gatHeight;
+		uint32_t gatTilesOffset;
+		uint32_t padding;
+	};
+	static const char magic[8];
+	static const uint32_t version = 2;
+
+	static std::string getMapName(const std::string &fileName);
+	static std::string getCacheFile(const std::string &mapName);
+	static uint64_t hashData(const char* data, size_t size);
+	static bool hashFile(const std::string &fileName, uint64_t &hash);
+	static void writeCache(const std::string &mapName, const Gnd* gnd, const Gat* gat, Header &header);
+public:
+	static std::string directory; //where the caches are stored, the cache is disabled when this is empty
+
+	static bool load(const std::string &fileName, Gnd* &gnd, Gat* &gat);
+	static void save(const std::string &fileName, const Gnd* gnd, const Gat* gat);
+	static void saveWritten(const std::string &fileName, const Gnd* gnd, const Gat* gat, const std::vector<char> &gndData, const std::vector<char> &gatData);
+};
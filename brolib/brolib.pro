@@ -24,26 +24,43 @@ windows
 LIBS += -lglew.lib
 LIBS += -lwinmm.lib
 
+# qmake CONFIG+=libdeflate inflates grf entries with libdeflate instead of zlib
+libdeflate {
+    DEFINES += GRF_USE_LIBDEFLATE
+    LIBS += -ldeflate
+}
+
 SOURCES += \
+    BroLib/BufferWriter.cpp \
     BroLib/Gnd.cpp \
     BroLib/GrfFileSystemHandler.cpp \
+    BroLib/GrfWriter.cpp \
     BroLib/Map.cpp \
     BroLib/MapRenderer.cpp \
+    BroLib/OverlayFileSystemHandler.cpp \
     BroLib/Rsm.cpp \
+    BroLib/RsmCache.cpp \
     BroLib/Rsw.cpp \
+    BroLib/WorkspaceCache.cpp \
     BroLib/grflib/grf.c \
     BroLib/grflib/grfcrypt.c \
     BroLib/grflib/grfsupport.c \
     BroLib/grflib/rgz.c
 
 HEADERS += \
+    BroLib/BufferReader.h \
+    BroLib/BufferWriter.h \
     BroLib/Gnd.h \
     BroLib/GrfFileSystemHandler.h \
+    BroLib/GrfWriter.h \
     BroLib/Map.h \
     BroLib/MapRenderer.h \
+    BroLib/OverlayFileSystemHandler.h \
     BroLib/Renderer.h \
     BroLib/Rsm.h \
+    BroLib/RsmCache.h \
     BroLib/Rsw.h \
+    BroLib/WorkspaceCache.h \
     BroLib/grflib/grf.h \
     BroLib/grflib/grfcrypt.h \
     BroLib/grflib/grfsupport.h \
@@ -0,0 +1,104 @@
+#include "Tests.h"
+#include "GrfCryptReference.h"
+#include <BroLib/grflib/grfcrypt.h>
+
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+
+static const uint8_t testFlags[] = { 0, GRFFILE_FLAG_MIXCRYPT, GRFFILE_FLAG_0x14_DES, GRFFILE_FLAG_MIXCRYPT | GRFFILE_FLAG_0x14_DES };
+
+typedef char* (*Process)(char *dst, const char *src, uint32_t len, uint8_t flags, uint32_t digitsGen, const char *ks, uint8_t dir);
+
+//decrypts a buffer in entries of the given size, and returns the MB/s of the fastest round
+static double benchmark(Process process, const std::vector<char> &data, uint8_t flags, uint32_t entrySize, int rounds)
+{
+	std::vector<char> out(data.size());
+	char keySchedule[0x80];
+	memset(keySchedule, 0, sizeof(keySchedule));
+	double best = 0;
+	for (int round = 0; round < rounds; round++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (size_t i = 0; i + entrySize <= data.size(); i += entrySize)
+			process(&out[i], &data[i], entrySize, flags, entrySize, keySchedule, GRFCRYPT_DECRYPT);
+		double ms = elapsedMs(begin);
+		if (ms > 0)
+			best = std::max(best, data.size() / (ms / 1000) / (1024 * 1024));
+	}
+	return best;
+}
+
+//checks the table driven DES of grfcrypt.c against the bit-by-bit version it replaced, on random data, keys, lengths and flags,
+//in both directions, and checks that decrypting undoes encrypting. Then reports the decryption speed of both
+int desTest(int argc, char* argv[])
+{
+	int iterations = argc > 0 ? atoi(argv[0]) : 20000;
+	size_t benchmarkSize = (argc > 1 ? atoi(argv[1]) : 4) * 1024 * 1024;
+
+	std::mt19937 random(42);
+	int failed = 0;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		char key[8], keySchedule[0x80], referenceKeySchedule[0x80];
+		for (char &c : key)
+			c = (char)random();
+		DES_CreateKeySchedule(keySchedule, key);
+		DES_CreateKeyScheduleReference(referenceKeySchedule, key);
+		if (memcmp(keySchedule, referenceKeySchedule, sizeof(keySchedule)) != 0)
+			failed++;
+	}
+	if (failed > 0)
+		printf("Key schedules: %d of 1000 differ\n", failed);
+
+	int differences = 0, roundTrips = 0;
+	for (int i = 0; i < iterations; i++)
+	{
+		//grf always uses a zeroed key schedule, random ones check the rounds as well
+		char keySchedule[0x80];
+		for (char &c : keySchedule)
+			c = i % 2 ? (char)random() : 0;
+		uint32_t len = 8 * (random() % 1024);
+		uint8_t flags = testFlags[random() % 4];
+		uint32_t digitsGen = random() % 2 ? len : (uint32_t)random() >> (random() % 32); //covers every cycle of the mixed crypt
+		std::vector<char> data(len), encrypted(len), decrypted(len), reference(len);
+		for (char &c : data)
+			c = (char)random();
+
+		for (uint8_t dir : { GRFCRYPT_ENCRYPT, GRFCRYPT_DECRYPT })
+		{
+			GRF_Process(encrypted.data(), data.data(), len, flags, digitsGen, keySchedule, dir);
+			GRF_ProcessReference(reference.data(), data.data(), len, flags, digitsGen, keySchedule, dir);
+			if (encrypted != reference)
+				differences++;
+		}
+
+		//a single round only undoes itself when the first and last subkey are the same, as they are in the zeroed schedule
+		if (i % 2 == 0)
+		{
+			GRF_Process(encrypted.data(), data.data(), len, flags, digitsGen, keySchedule, GRFCRYPT_ENCRYPT);
+			GRF_Process(decrypted.data(), encrypted.data(), len, flags, digitsGen, keySchedule, GRFCRYPT_DECRYPT);
+			if (decrypted != data)
+				roundTrips++;
+		}
+	}
+	printf("%d buffers: %d differ from the reference, %d don't round trip\n", iterations, differences, roundTrips);
+	failed += differences + roundTrips;
+
+	std::vector<char> data(benchmarkSize);
+	for (char &c : data)
+		c = (char)random();
+	//mixcrypt entries only crypt some of their blocks, 0x14 des entries only their first 0x14 blocks, so those are benchmarked on entries of exactly that size
+	printf("mixcrypt decrypt, 64kb entries: %7.1fMB/s, reference %7.1fMB/s\n",
+		benchmark(GRF_Process, data, GRFFILE_FLAG_MIXCRYPT, 64 * 1024, 5), benchmark(GRF_ProcessReference, data, GRFFILE_FLAG_MIXCRYPT, 64 * 1024, 2));
+	printf("0x14 des decrypt, 160b entries: %7.1fMB/s, reference %7.1fMB/s\n",
+		benchmark(GRF_Process, data, GRFFILE_FLAG_0x14_DES, 0x14 * 8, 5), benchmark(GRF_ProcessReference, data, GRFFILE_FLAG_0x14_DES, 0x14 * 8, 2));
+
+	printf(failed == 0 ? "Passed\n" : "Failed\n");
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include "Tests.h"
+#include <BroLib/Gnd.h>
+#include <BroLib/BufferReader.h>
+#include <blib/util/FileSystem.h>
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+
+//loads the gnd of a map a few times, and reports how long reading the file takes, and how long the whole load takes,
+//so the time spent parsing and calculating normals is the difference between the two
+int gndBenchmark(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: brotest gnd <grf or ro directory> <map> [runs]\n");
+		return 1;
+	}
+	addDataSource(argv[0]);
+	std::string fileName = std::string("data/") + argv[1];
+	int runs = argc > 2 ? std::max(1, atoi(argv[2])) : 10;
+
+	double bestRead = 1e30;
+	size_t fileSize = 0;
+	for (int run = 0; run < runs; run++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		blib::util::StreamInFile* file = blib::util::FileSystem::openRead(fileName + ".gnd");
+		if (!file || !file->opened())
+		{
+			printf("Unable to open %s.gnd\n", fileName.c_str());
+			delete file;
+			return 1;
+		}
+		std::vector<char> buffer;
+		BufferReader::readAll(file, buffer);
+		delete file;
+		bestRead = std::min(bestRead, elapsedMs(begin));
+		fileSize = buffer.size();
+	}
+
+	double bestLoad = 1e30, totalLoad = 0;
+	int width = 0, height = 0;
+	size_t tileCount = 0, lightmapCount = 0;
+	for (int run = 0; run < runs; run++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		Gnd* gnd = new Gnd(fileName);
+		double ms = elapsedMs(begin);
+		bestLoad = std::min(bestLoad, ms);
+		totalLoad += ms;
+		width = gnd->width;
+		height = gnd->height;
+		tileCount = gnd->tiles.size();
+		lightmapCount = gnd->lightmaps.size();
+		delete gnd;
+	}
+	if (width == 0 || height == 0)
+	{
+		printf("%s.gnd is not a valid gnd file\n", fileName.c_str());
+		return 1;
+	}
+
+	printf("%s.gnd: %.1f KB, %dx%d cubes, %zu tiles, %zu lightmaps\n", fileName.c_str(), fileSize / 1024.0, width, height, tileCount, lightmapCount);
+	printf("read: %.2f ms, load: %.2f ms best, %.2f ms average over %d runs\n", bestRead, bestLoad, totalLoad / runs, runs);
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include "GndReference.h"
+
+#include <blib/util/FileSystem.h>
+
+
+bool GndReference::load(const std::string &fileName)
+{
+	blib::util::StreamInFile* file = blib::util::FileSystem::openRead(fileName + ".gnd");
+	if (!file || !file->opened())
+	{
+		delete file;
+		return false;
+	}
+	char header[4];
+	file->read(header, 4);
+	if (header[0] == 'G' && header[1] == 'R' && header[2] == 'G' && header[3] == 'N')
+		version = file->readShort();
+	else
+		version = 0;
+
+	int textureCount = 0;
+
+	if (version > 0)
+	{
+		width = file->readInt();
+		height = file->readInt();
+		tileScale = file->readFloat();
+		textureCount = file->readInt();
+		maxTexName = file->readInt();
+	}
+	else
+	{
+		file->seek(6, blib::util::StreamSeekable::CURRENT);
+		width = file->readInt();
+		height = file->readInt();
+		textureCount = file->readInt();
+	}
+
+	//the old loader trusted the counts, a broken file is only compared up to where it ends
+	for (int i = 0; i < textureCount && !file->eof(); i++)
+	{
+		Texture texture;
+		texture.file = file->readString(40);
+		texture.name = file->readString(40);
+		textures.push_back(texture);
+	}
+
+	if (version > 0)
+	{
+		int lightmapCount = file->readInt();
+		lightmapWidth = file->readInt();
+		lightmapHeight = file->readInt();
+		gridSizeCell = file->readInt();
+
+		if (lightmapWidth != 8 || lightmapHeight != 8 || gridSizeCell != 1)
+		{
+			lightmapWidth = 8;
+			lightmapHeight = 8;
+			gridSizeCell = 1;
+		}
+
+		for (int i = 0; i < lightmapCount && !file->eof(); i++)
+		{
+			Lightmap lightmap;
+			file->read((char*)lightmap.data, 256);
+			lightmaps.push_back(lightmap);
+		}
+
+		int tileCount = file->readInt();
+		for (int i = 0; i < tileCount && !file->eof(); i++)
+		{
+			Tile tile;
+			tile.v1.x = file->readFloat();
+			tile.v2.x = file->readFloat();
+			tile.v3.x = file->readFloat();
+			tile.v4.x = file->readFloat();
+			tile.v1.y = file->readFloat();
+			tile.v2.y = file->readFloat();
+			tile.v3.y = file->readFloat();
+			tile.v4.y = file->readFloat();
+			tile.textureIndex = file->readWord();
+			tile.lightmapIndex = file->readUWord();
+			if (tile.lightmapIndex < 0 || tile.lightmapIndex == (unsigned short)-1)
+				tile.lightmapIndex = 0;
+			tile.color.b = (unsigned char)file->get();
+			tile.color.g = (unsigned char)file->get();
+			tile.color.r = (unsigned char)file->get();
+			tile.color.a = (unsigned char)file->get();
+			tiles.push_back(tile);
+		}
+
+		for (int y = 0; y < height && !file->eof(); y++)
+		{
+			for (int x = 0; x < width && !file->eof(); x++)
+			{
+				Cube cube;
+				for (int i = 0; i < 4; i++)
+					cube.heights[i] = file->readFloat();
+				for (int i = 0; i < 3; i++)
+				{
+					cube.tileIds[i] = version >= 0x0106 ? file->readInt() : file->readUWord();
+					if (cube.tileIds[i] >= (int)tiles.size())
+						cube.tileIds[i] = -1;
+				}
+				cubes.push_back(cube);
+			}
+		}
+	}
+	delete file;
+	return true;
+}
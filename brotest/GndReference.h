@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+//the gnd loader as it was before it decoded the file from one buffer: it reads the file value by value from the stream,
+//into plain records instead of the flat arrays. Only used by brotest, to check the current loader against
+class GndReference
+{
+public:
+	class Texture
+	{
+	public:
+		std::string name;
+		std::string file;
+	};
+
+	class Lightmap
+	{
+	public:
+		unsigned char data[256];
+	};
+
+	class Tile
+	{
+	public:
+		glm::vec2 v1, v2, v3, v4;
+		int textureIndex;
+		int lightmapIndex;
+		glm::ivec4 color;
+	};
+
+	class Cube
+	{
+	public:
+		float heights[4];
+		int tileIds[3];
+	};
+
+	short version;
+	int width;
+	int height;
+	float tileScale;
+	int maxTexName;
+	int lightmapWidth;
+	int lightmapHeight;
+	int gridSizeCell;
+	std::vector<Texture> textures;
+	std::vector<Lightmap> lightmaps;
+	std::vector<Tile> tiles;
+	std::vector<Cube> cubes; //row by row, as in the file
+
+	bool load(const std::string &fileName);
+};
@@ -0,0 +1,128 @@
+#include "Tests.h"
+#include "GndReference.h"
+#include <BroLib/Gnd.h>
+#include <blib/util/FileSystem.h>
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+//compares the parsed fields of a gnd to the reference loader, and returns a description of the first difference,
+//or an empty string if there is none
+static std::string compare(const Gnd* gnd, const GndReference &ref)
+{
+	char buf[256];
+	if (gnd->version != ref.version || gnd->width != ref.width || gnd->height != ref.height)
+	{
+		sprintf(buf, "header: version %x, %dx%d, reference version %x, %dx%d", gnd->version, gnd->width, gnd->height, ref.version, ref.width, ref.height);
+		return buf;
+	}
+	if (ref.version == 0)
+		return "";
+	if (memcmp(&gnd->tileScale, &ref.tileScale, sizeof(float)) != 0 || gnd->maxTexName != ref.maxTexName ||
+		gnd->lightmapWidth != ref.lightmapWidth || gnd->lightmapHeight != ref.lightmapHeight || gnd->gridSizeCell != ref.gridSizeCell)
+		return "header: tile scale, texture name length or lightmap format";
+
+	if (gnd->textures.size() != ref.textures.size())
+		return "texture count";
+	for (size_t i = 0; i < ref.textures.size(); i++)
+	{
+		if (gnd->textures[i]->file != ref.textures[i].file || gnd->textures[i]->name != ref.textures[i].name)
+		{
+			sprintf(buf, "texture %zu", i);
+			return buf;
+		}
+	}
+
+	if (gnd->lightmaps.size() != ref.lightmaps.size())
+		return "lightmap count";
+	for (size_t i = 0; i < ref.lightmaps.size(); i++)
+	{
+		if (memcmp(gnd->lightmaps[i].data, ref.lightmaps[i].data, 256) != 0)
+		{
+			sprintf(buf, "lightmap %zu", i);
+			return buf;
+		}
+	}
+
+	if (gnd->tiles.size() != ref.tiles.size())
+		return "tile count";
+	for (size_t i = 0; i < ref.tiles.size(); i++)
+	{
+		const Gnd::Tile &a = gnd->tiles[i];
+		const GndReference::Tile &b = ref.tiles[i];
+		if (memcmp(&a.v1, &b.v1, sizeof(glm::vec2)) != 0 || memcmp(&a.v2, &b.v2, sizeof(glm::vec2)) != 0 ||
+			memcmp(&a.v3, &b.v3, sizeof(glm::vec2)) != 0 || memcmp(&a.v4, &b.v4, sizeof(glm::vec2)) != 0 ||
+			a.textureIndex != b.textureIndex || a.lightmapIndex != b.lightmapIndex || a.color != b.color)
+		{
+			sprintf(buf, "tile %zu", i);
+			return buf;
+		}
+	}
+
+	if (ref.cubes.size() != (size_t)gnd->width * gnd->height)
+		return "cube count";
+	for (size_t i = 0; i < ref.cubes.size(); i++)
+	{
+		if (memcmp(&gnd->cubeHeights[4 * i], ref.cubes[i].heights, 4 * sizeof(float)) != 0 ||
+			memcmp(&gnd->cubeTileIds[3 * i], ref.cubes[i].tileIds, 3 * sizeof(int)) != 0)
+		{
+			sprintf(buf, "cube %zu, %zu", i % gnd->width, i / gnd->width);
+			return buf;
+		}
+	}
+	return "";
+}
+
+//loads gnds with both the current loader and the reference copy of the old one, and compares every field they parse.
+//Without map names, every gnd in the data directory is compared
+int gndCompare(int argc, char* argv[])
+{
+	if (argc < 1)
+	{
+		printf("Usage: brotest gndcompare <grf or ro directory> [map...]\n");
+		return 1;
+	}
+	addDataSource(argv[0]);
+
+	std::vector<std::string> maps;
+	for (int i = 1; i < argc; i++)
+		maps.push_back(std::string("data/") + argv[i]);
+	if (maps.empty())
+	{
+		for (std::string fileName : blib::util::FileSystem::getFileList("data/"))
+		{
+			std::transform(fileName.begin(), fileName.end(), fileName.begin(), ::tolower);
+			if (fileName.size() > 4 && fileName.compare(fileName.size() - 4, 4, ".gnd") == 0)
+				maps.push_back(fileName.substr(0, fileName.size() - 4));
+		}
+		std::sort(maps.begin(), maps.end());
+	}
+
+	int failed = 0, compared = 0;
+	for (const std::string &map : maps)
+	{
+		GndReference ref;
+		if (!ref.load(map))
+		{
+			printf("%s: unable to open\n", map.c_str());
+			failed++;
+			continue;
+		}
+		Gnd* gnd = new Gnd(map);
+		std::string difference = compare(gnd, ref);
+		printf("%s: version %x, %dx%d, %zu textures, %zu lightmaps, %zu tiles%s%s\n", map.c_str(), ref.version, ref.width, ref.height,
+			ref.textures.size(), ref.lightmaps.size(), ref.tiles.size(), difference.empty() ? "" : ", differs at ", difference.c_str());
+		if (!difference.empty())
+			failed++;
+		compared++;
+		delete gnd;
+	}
+
+	printf("%d of %zu gnds differ from the reference\n", failed, maps.size());
+	printf(failed == 0 && compared > 0 ? "Passed\n" : "Failed\n");
+	return failed == 0 && compared > 0 ? 0 : 1;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <BroLib/grflib/grftypes.h>
+
+GRFEXTERN_BEGIN
+
+/* The DES of grfcrypt.c as it was before it was made table driven. Same parameters as
+ * DES_CreateKeySchedule and GRF_Process */
+char *DES_CreateKeyScheduleReference(char *ks, const char *key);
+char *GRF_ProcessReference(char *dst, const char *src, uint32_t len, uint8_t flags, uint32_t digitsGen, const char *ks, uint8_t dir);
+
+GRFEXTERN_END
@@ -0,0 +1,150 @@
+#include "Tests.h"
+#include <BroLib/GrfFileSystemHandler.h>
+#include <BroLib/GrfWriter.h>
+#include <BroLib/BufferReader.h>
+#include <BroLib/grflib/grf.h>
+
+#include <zlib.h>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+
+
+//a grf with files of all sizes, compressible and random, including some that are big enough to be streamed
+static bool makeTestGrf(const std::string &fileName)
+{
+	std::remove(fileName.c_str());
+	GrfWriter writer(fileName);
+	if (!writer.opened())
+		return false;
+	std::mt19937 random(1234);
+	for (int i = 0; i < 400; i++)
+	{
+		size_t size = i % 50 == 0 ? GrfFileSystemHandler::streamThreshold + random() % (2 * 1024 * 1024) : random() % (i % 2 ? 200000 : 2000);
+		std::vector<char> data(size);
+		for (size_t ii = 0; ii < size; ii++)
+			data[ii] = i % 3 == 0 ? (char)random() : (char)('a' + (ii / 7 + i) % 26);
+		writer.add("data\\stress\\" + std::to_string(i % 10) + "\\file" + std::to_string(i) + ".bin", data.data(), data.size());
+	}
+	return writer.write();
+}
+
+class Reference
+{
+public:
+	uint32_t size;
+	uint32_t crc;
+};
+
+//runs a function on several threads at once, each reading all files in a different order, and counts the files that don't match
+static int runThreads(int threadCount, int rounds, const std::vector<int> &files, const std::function<bool(int file)> &check)
+{
+	std::atomic<int> errors(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; t++)
+	{
+		threads.push_back(std::thread([t, rounds, &files, &check, &errors]()
+		{
+			std::vector<int> order(files);
+			std::mt19937 random(t);
+			for (int round = 0; round < rounds; round++)
+			{
+				std::shuffle(order.begin(), order.end(), random);
+				for (int file : order)
+					if (!check(file))
+						errors++;
+			}
+		}));
+	}
+	for (std::thread &thread : threads)
+		thread.join();
+	return errors;
+}
+
+//extracts every file of a grf on several threads at once, through grflib with and without the archive mapped, and through
+//GrfFileSystemHandler with a cache that is too small to hold them. Every extracted file is checked against a single threaded extraction.
+//Without a grf, a test grf is made first
+int grfStressTest(int argc, char* argv[])
+{
+	std::string grfFile = argc > 0 ? argv[0] : "brotest_stress.grf";
+	int threadCount = argc > 1 ? atoi(argv[1]) : 8;
+	int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	if (argc == 0 && !makeTestGrf(grfFile))
+	{
+		printf("Unable to make test grf %s\n", grfFile.c_str());
+		return 1;
+	}
+
+	GrfError error;
+	Grf* grf = grf_open(grfFile.c_str(), "rb", &error);
+	if (!grf)
+	{
+		printf("Unable to open %s: %s\n", grfFile.c_str(), grf_strerror(error));
+		return 1;
+	}
+
+	std::vector<int> files;
+	std::vector<Reference> reference(grf->nfiles);
+	for (unsigned int i = 0; i < grf->nfiles; i++)
+	{
+		if (GRFFILE_IS_DIR(grf->files[i]))
+			continue;
+		std::vector<char> data(grf->files[i].real_len + 1);
+		uint32_t size = 0;
+		if (!grf_index_read(grf, i, data.data(), &size, &error))
+		{
+			printf("Unable to extract %s: %s\n", grf->files[i].name, grf_strerror(error));
+			continue;
+		}
+		reference[i] = Reference{ size, (uint32_t)crc32(0, (const Bytef*)data.data(), size) };
+		files.push_back(i);
+	}
+	printf("%s: %d files, %d threads, %d rounds\n", grfFile.c_str(), (int)files.size(), threadCount, rounds);
+
+	int failed = 0;
+	for (int mapped = 1; mapped >= 0; mapped--)
+	{
+		//without the mapping, the entries are read with positional reads on the shared file
+		void* map = grf->map;
+		if (!mapped)
+			grf->map = NULL;
+		auto begin = std::chrono::steady_clock::now();
+		int errors = runThreads(threadCount, rounds, files, [grf, &reference](int file)
+		{
+			std::vector<char> data(grf->files[file].real_len + 1);
+			uint32_t size = 0;
+			GrfError error;
+			if (!grf_index_read(grf, file, data.data(), &size, &error))
+				return false;
+			return size == reference[file].size && crc32(0, (const Bytef*)data.data(), size) == reference[file].crc;
+		});
+		grf->map = map;
+		printf("grflib %s: %d errors, %.0fms\n", mapped ? "mapped" : "positional reads", errors, elapsedMs(begin));
+		failed += errors;
+	}
+
+	//the cache of the handler can only hold a few files, so files get extracted and evicted all the time
+	GrfFileSystemHandler handler(grfFile, 512 * 1024);
+	auto begin = std::chrono::steady_clock::now();
+	int errors = runThreads(threadCount, rounds, files, [grf, &handler, &reference](int file)
+	{
+		blib::util::StreamInFile* stream = handler.openRead(grf->files[file].name);
+		if (!stream)
+			return false;
+		std::vector<char> data;
+		BufferReader::readAll(stream, data);
+		delete stream;
+		return data.size() == reference[file].size && crc32(0, (const Bytef*)data.data(), data.size()) == reference[file].crc;
+	});
+	printf("GrfFileSystemHandler: %d errors, %.0fms\n", errors, elapsedMs(begin));
+	failed += errors;
+
+	grf_close(grf);
+	printf(failed == 0 ? "Passed\n" : "Failed\n");
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include "Tests.h"
+#include <BroLib/GrfFileSystemHandler.h>
+#include <BroLib/grflib/grf.h>
+
+#include <zlib.h>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+class Corpus
+{
+public:
+	std::string name;
+	std::vector<std::string> extensions;
+	std::vector<std::vector<char>> blocks;
+	std::vector<uint32_t> sizes;
+	size_t totalSize;
+};
+
+typedef std::function<bool(char* dest, uint32_t destLen, const char* src, uint32_t srcLen)> Inflater;
+
+//inflates every block of a corpus a few times, and returns the inflated MB/s of the fastest round
+static double benchmark(const Corpus &corpus, int rounds, const Inflater &inflate, bool &failed)
+{
+	std::vector<char> buffer;
+	double best = 0;
+	for (int round = 0; round < rounds; round++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < corpus.blocks.size(); i++)
+		{
+			buffer.resize(corpus.sizes[i]);
+			if (!inflate(buffer.data(), corpus.sizes[i], corpus.blocks[i].data(), (uint32_t)corpus.blocks[i].size()))
+				failed = true;
+		}
+		double ms = elapsedMs(begin);
+		if (ms > 0)
+			best = std::max(best, corpus.totalSize / (ms / 1000) / (1024 * 1024));
+	}
+	return best;
+}
+
+//inflates the compressed gnd, rsm and texture entries of a grf with zlib, and with the inflater grflib is built with,
+//and reports the MB/s of both. Build with CONFIG+=libdeflate to compare libdeflate to zlib
+int inflateBenchmark(int argc, char* argv[])
+{
+	if (argc < 1)
+	{
+		printf("Usage: brotest inflate <grf> [entries per type] [rounds]\n");
+		return 1;
+	}
+	size_t maxEntries = argc > 1 ? atoi(argv[1]) : 500;
+	int rounds = argc > 2 ? atoi(argv[2]) : 5;
+
+	GrfError error;
+	Grf* grf = grf_open(argv[0], "rb", &error);
+	if (!grf)
+	{
+		printf("Unable to open %s: %s\n", argv[0], grf_strerror(error));
+		return 1;
+	}
+
+	std::vector<Corpus> corpora(3);
+	corpora[0].name = "gnd";
+	corpora[0].extensions = { ".gnd" };
+	corpora[1].name = "rsm";
+	corpora[1].extensions = { ".rsm" };
+	corpora[2].name = "texture";
+	corpora[2].extensions = { ".bmp", ".tga", ".jpg", ".png" };
+
+	//the entries are spread over the whole archive, so the corpus isn't just the files of a single map
+	for (Corpus &corpus : corpora)
+	{
+		std::vector<uint32_t> entries;
+		for (uint32_t i = 0; i < grf->nfiles; i++)
+		{
+			const GrfFile &file = grf->files[i];
+			if (GRFFILE_IS_DIR(file) || file.compressed_len == file.real_len || file.real_len == 0)
+				continue;
+			std::string name = GrfFileSystemHandler::sanitizeFileName(file.name);
+			for (const std::string &extension : corpus.extensions)
+				if (name.size() > extension.size() && name.compare(name.size() - extension.size(), extension.size(), extension) == 0)
+					entries.push_back(i);
+		}
+		size_t step = std::max((size_t)1, entries.size() / std::max((size_t)1, maxEntries));
+		corpus.totalSize = 0;
+		for (size_t i = 0; i < entries.size() && corpus.blocks.size() < maxEntries; i += step)
+		{
+			uint32_t size, realSize;
+			const char* block = (const char*)grf_index_get_z(grf, entries[i], &size, &realSize, &error);
+			if (!block)
+				continue;
+			size = std::min(size, grf->files[entries[i]].compressed_len);
+			corpus.blocks.push_back(std::vector<char>(block, block + size));
+			corpus.sizes.push_back(realSize);
+			corpus.totalSize += realSize;
+		}
+	}
+	grf_close(grf);
+
+	Inflater zlibInflate = [](char* dest, uint32_t destLen, const char* src, uint32_t srcLen)
+	{
+		uLongf len = destLen;
+		return uncompress((Bytef*)dest, &len, (const Bytef*)src, srcLen) == Z_OK && len == destLen;
+	};
+	Inflater grfInflate = [](char* dest, uint32_t destLen, const char* src, uint32_t srcLen)
+	{
+		uint32_t len = destLen;
+		return GRF_Inflate(dest, &len, src, srcLen) == Z_OK && len == destLen;
+	};
+	bool compare = strcmp(GRF_InflateBackend(), "zlib") != 0;
+
+	bool failed = false;
+	for (const Corpus &corpus : corpora)
+	{
+		if (corpus.blocks.empty())
+		{
+			printf("%-8s no compressed entries\n", corpus.name.c_str());
+			continue;
+		}
+		printf("%-8s %5d entries, %7dkb: zlib %6.0fMB/s", corpus.name.c_str(), (int)corpus.blocks.size(), (int)(corpus.totalSize / 1024), benchmark(corpus, rounds, zlibInflate, failed));
+		if (compare)
+			printf(", %s %6.0fMB/s", GRF_InflateBackend(), benchmark(corpus, rounds, grfInflate, failed));
+		printf("\n");
+	}
+	if (failed)
+		printf("Some entries failed to inflate\n");
+	return failed ? 1 : 0;
+}
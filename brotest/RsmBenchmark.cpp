@@ -0,0 +1,97 @@
+#include "Tests.h"
+#include <BroLib/Rsm.h>
+#include <BroLib/BufferReader.h>
+#include <blib/util/FileSystem.h>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+
+//loads every model of the object browser's model list a few times, and reports how long reading the files takes,
+//and how long loading them as models takes, so the time spent parsing is the difference between the two
+int rsmBenchmark(int argc, char* argv[])
+{
+	if (argc < 1)
+	{
+		printf("Usage: brotest rsm <grf or ro directory> [model list] [runs]\n");
+		return 1;
+	}
+	addDataSource(argv[0]);
+	std::string listFile = argc > 1 ? argv[1] : "assets/romodels.txt";
+	int runs = argc > 2 ? std::max(1, atoi(argv[2])) : 3;
+
+	//lines are the path in the object browser, followed by the file name, as in folder/name|data\model\name.rsm
+	std::ifstream list(listFile);
+	if (!list)
+	{
+		printf("Unable to open %s\n", listFile.c_str());
+		return 1;
+	}
+	std::vector<std::string> fileNames;
+	std::string line;
+	while (std::getline(list, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.find("|") != std::string::npos)
+			fileNames.push_back(line.substr(line.find("|") + 1));
+	}
+
+	//only the models that are in the data source are benchmarked
+	std::vector<std::string> models;
+	size_t totalSize = 0;
+	for (const std::string &fileName : fileNames)
+	{
+		blib::util::StreamInFile* file = blib::util::FileSystem::openRead(fileName);
+		if (file && file->opened())
+		{
+			std::vector<char> buffer;
+			BufferReader::readAll(file, buffer);
+			totalSize += buffer.size();
+			models.push_back(fileName);
+		}
+		delete file;
+	}
+	printf("%zu of %zu models found, %.1f MB\n", models.size(), fileNames.size(), totalSize / (1024.0 * 1024.0));
+	if (models.empty())
+		return 1;
+
+	double bestRead = 1e30;
+	for (int run = 0; run < runs; run++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (const std::string &fileName : models)
+		{
+			blib::util::StreamInFile* file = blib::util::FileSystem::openRead(fileName);
+			std::vector<char> buffer;
+			BufferReader::readAll(file, buffer);
+			delete file;
+		}
+		bestRead = std::min(bestRead, elapsedMs(begin));
+	}
+
+	double bestLoad = 1e30;
+	size_t failed = 0;
+	for (int run = 0; run < runs; run++)
+	{
+		failed = 0;
+		auto begin = std::chrono::steady_clock::now();
+		for (const std::string &fileName : models)
+		{
+			Rsm* rsm = new Rsm(fileName);
+			if (!rsm->loaded)
+				failed++;
+			delete rsm;
+		}
+		bestLoad = std::min(bestLoad, elapsedMs(begin));
+	}
+
+	if (failed > 0)
+		printf("%zu models failed to load\n", failed);
+	printf("read: %.1f ms, load: %.1f ms, %.0f models/s, best of %d runs\n", bestRead, bestLoad, models.size() / (bestLoad / 1000), runs);
+	return 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+
+//tests and benchmarks for brolib, run as brotest <name> [arguments]. Tests return 0 when they pass
+
+int grfStressTest(int argc, char* argv[]);
+int inflateBenchmark(int argc, char* argv[]);
+int desTest(int argc, char* argv[]);
+int gndBenchmark(int argc, char* argv[]);
+int gndCompare(int argc, char* argv[]);
+int rsmBenchmark(int argc, char* argv[]);
+
+//registers a grf, or a directory that contains a data folder, to read files from
+void addDataSource(const std::string &path);
+double elapsedMs(std::chrono::steady_clock::time_point begin);
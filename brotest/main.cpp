@@ -0,0 +1,50 @@
+#include "Tests.h"
+#include <BroLib/GrfFileSystemHandler.h>
+#include <blib/util/FileSystem.h>
+
+#include <cstdio>
+#include <cstring>
+
+class Test
+{
+public:
+	const char* name;
+	const char* usage;
+	int(*run)(int argc, char* argv[]);
+};
+
+static const Test tests[] =
+{
+	{ "grfstress", "[grf] [threads] [rounds]", grfStressTest },
+	{ "inflate", "<grf> [entries per type] [rounds]", inflateBenchmark },
+	{ "des", "[iterations] [benchmark MB]", desTest },
+	{ "gnd", "<grf or ro directory> <map> [runs]", gndBenchmark },
+	{ "gndcompare", "<grf or ro directory> [map...]", gndCompare },
+	{ "rsm", "<grf or ro directory> [model list] [runs]", rsmBenchmark },
+};
+
+void addDataSource(const std::string &path)
+{
+	if (path.size() > 4 && path.compare(path.size() - 4, 4, ".grf") == 0)
+		blib::util::FileSystem::registerHandler(new GrfFileSystemHandler(path));
+	else
+		blib::util::FileSystem::registerHandler(new blib::util::PhysicalFileSystemHandler(path));
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 2)
+		for (const Test &test : tests)
+			if (strcmp(argv[1], test.name) == 0)
+				return test.run(argc - 2, argv + 2);
+
+	printf("Usage: brotest <test> [arguments]\n");
+	for (const Test &test : tests)
+		printf("  %s %s\n", test.name, test.usage);
+	return 1;
+}
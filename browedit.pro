@@ -4,4 +4,5 @@ QMAKE_CXXFLAGS += -Wno-unused-variable
 
 SUBDIRS += blib/blib.pro \
     brolib \
-    browedit
+    browedit \
+    brotest
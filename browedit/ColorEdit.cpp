@@ -21,12 +21,19 @@ void BrowEdit::colorEditUpdate()
 		{
 			if (map->inMap(cursorX, cursorY))
 			{
-				int tileUp = map->getGnd()->cubes[cursorX][cursorY]->tileUp;
+				int tileUp = map->getGnd()->cube(cursorX, cursorY).tileUp;
 				if (tileUp > -1)
 				{
-					Gnd::Tile* tile = map->getGnd()->tiles[tileUp];
-					tile->color = glm::vec4(colorWindow->color * 255.0f, 255.0f);
-					mapRenderer.setColorDirty();
+					glm::ivec4 color = glm::ivec4(glm::vec4(colorWindow->color * 255.0f, 255.0f));
+					if (map->getGnd()->tiles[tileUp].color != color)
+					{
+						//tiles are shared between cubes, so the painted cube gets another tile instead of changing this one
+						Gnd::Tile tile = map->getGnd()->tiles[tileUp];
+						tile.color = color;
+						map->getGnd()->cube(cursorX, cursorY).tileUp = map->getGnd()->addTile(tile);
+						mapRenderer.setTileDirty(cursorX, cursorY);
+						mapRenderer.setColorDirty();
+					}
 				}
 			}
 		}
@@ -30,7 +30,7 @@ void BrowEdit::detailGatEditUpdate()
 			auto changeHeight = [this, gat](const glm::ivec2 &pos, const glm::vec2 &off, float diff){
 				if (!map->inMap(pos.x/2, pos.y/2))
 					return;
-				Gat::Tile* tile = gat->tiles[pos.x][pos.y];
+				Gat::Tile &tile = gat->tile(pos.x, pos.y);
 				int primIndex = 0;
 				if (off.x < 0.5 && off.y > 0.5)
 					primIndex = 0;
@@ -41,7 +41,7 @@ void BrowEdit::detailGatEditUpdate()
 				else if (off.x > 0.5 && off.y < 0.5)
 					primIndex = 3;
 
-				tile->heights[primIndex] += diff;
+				tile.heights[primIndex] += diff;
 			};
 
 			float diff = (mouseState.position.y - lastMouseState.position.y) / 10.0f;
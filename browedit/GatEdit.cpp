@@ -25,15 +25,15 @@ void BrowEdit::gatEditUpdate()
 				blib::math::Polygon polygon;
 				for (size_t i = 0; i < selectLasso.size(); i++)
 					polygon.push_back(glm::vec2(selectLasso[i]));
-				for (int x = 0; x < map->getGat()->width; x++)
+				for (int y = 0; y < map->getGat()->height; y++)
 				{
-					for (int y = 0; y < map->getGat()->height; y++)
+					for (int x = 0; x < map->getGat()->width; x++)
 					{
-						map->getGat()->tiles[x][y]->selected = polygon.contains(glm::vec2(x, y));
+						map->getGat()->selected(x, y) = polygon.contains(glm::vec2(x, y));
 					}
 				}
 				for (size_t i = 0; i < selectLasso.size(); i++)
-					map->getGat()->tiles[selectLasso[i].x][selectLasso[i].y]->selected = true;
+					map->getGat()->selected(selectLasso[i].x, selectLasso[i].y) = true;
 				selectLasso.clear();
 			}
 		}
@@ -64,11 +64,11 @@ void BrowEdit::gatEditUpdate()
 				glm::vec2 br = glm::vec2(glm::ceil(glm::max(mouse3dstart.x, mapRenderer.mouse3d.x) / 5.0f), glm::ceil(glm::max(mouse3dstart.z, mapRenderer.mouse3d.z) / 5.0f) - 1);
 				blib::math::Rectangle rect(tl, br);
 
-				for (int x = 0; x < map->getGat()->width; x++)
+				for (int y = 0; y < map->getGat()->height; y++)
 				{
-					for (int y = 0; y < map->getGat()->height; y++)
+					for (int x = 0; x < map->getGat()->width; x++)
 					{
-						map->getGat()->tiles[x][y]->selected = rect.contains(glm::vec2(x, map->getGat()->height - y));
+						map->getGat()->selected(x, y) = rect.contains(glm::vec2(x, map->getGat()->height - y));
 					}
 				}
 			}
@@ -77,11 +77,11 @@ void BrowEdit::gatEditUpdate()
 		if (!mouseState.rightButton && lastMouseState.rightButton)
 		{
 			bool moved = false;
-			for (int x = 0; x < map->getGat()->width; x++)
+			for (int y = 0; y < map->getGat()->height; y++)
 			{
-				for (int y = 0; y < map->getGat()->height; y++)
+				for (int x = 0; x < map->getGat()->width; x++)
 				{
-					if (!map->getGat()->tiles[x][y]->selected)
+					if (!map->getGat()->selected(x, y))
 						continue;
 					moved = true;
 					for (int xx = -1; xx <= 1; xx++)
@@ -98,11 +98,11 @@ void BrowEdit::gatEditUpdate()
 
 			float diff = (float)(mouseState.position.y - lastMouseState.position.y);
 			bool moved = false;
-			for (int x = 0; x < map->getGat()->width; x++)
+			for (int y = 0; y < map->getGat()->height; y++)
 			{
-				for (int y = 0; y < map->getGat()->height; y++)
+				for (int x = 0; x < map->getGat()->width; x++)
 				{
-					if (!map->getGat()->tiles[x][y]->selected)
+					if (!map->getGat()->selected(x, y))
 					{
 						if (around)
 						{
@@ -114,29 +114,29 @@ void BrowEdit::gatEditUpdate()
 									if (x + xx < 0 || x + xx >= map->getGat()->width ||
 										y + yy < 0 || y + yy >= map->getGat()->height)
 										continue;
-									if (!map->getGat()->tiles[x + xx][y + yy]->selected)
+									if (!map->getGat()->selected(x + xx, y + yy))
 										continue;
 
 									if (((xx == 1 && yy != 1) || (xx == 0 && yy == -1)) && !changedCorners[1])
 									{
-										map->getGat()->tiles[x][y]->heights[1] += diff;
+										map->getGat()->tile(x, y).heights[1] += diff;
 										changedCorners[1] = true;
 									}
 									if (((xx == 1 && yy != -1) || (xx == 0 && yy == 1)) && !changedCorners[3])
 									{
-										map->getGat()->tiles[x][y]->heights[3] += diff;
+										map->getGat()->tile(x, y).heights[3] += diff;
 										changedCorners[3] = true;
 									}
 
 									if (((xx == -1 && yy != 1) || (xx == 0 && yy == -1)) && !changedCorners[0])
 									{
-										map->getGat()->tiles[x][y]->heights[0] += diff;
+										map->getGat()->tile(x, y).heights[0] += diff;
 										changedCorners[0] = true;
 									}
 
 									if (((xx == -1 && yy != -1) || (xx == 0 && yy == 1)) && !changedCorners[2])
 									{
-										map->getGat()->tiles[x][y]->heights[2] += diff;
+										map->getGat()->tile(x, y).heights[2] += diff;
 										changedCorners[2] = true;
 									}
 								}
@@ -146,7 +146,7 @@ void BrowEdit::gatEditUpdate()
 					}
 					moved = true;
 					for (int i = 0; i < 4; i++)
-						map->getGat()->tiles[x][y]->heights[i] += diff;
+						map->getGat()->tile(x, y).heights[i] += diff;
 				}
 			}
 		}
@@ -160,8 +160,7 @@ void BrowEdit::gatEditUpdate()
 			{
 				for (int y = 0; y < map->getGat()->height; y++)
 				{
-					Gat::Tile* c = map->getGat()->tiles[x][y];
-					if (c->selected)
+					if (map->getGat()->selected(x, y))
 					{
 						float avgs[4] = { 0, 0, 0, 0 };
 						for (int i = 0; i < 4; i++)
@@ -173,7 +172,7 @@ void BrowEdit::gatEditUpdate()
 								int yy = y + (-(ii / 2)) + (i / 2);
 								if (map->inMap(xx, yy))
 								{
-									avgs[i] += map->getGat()->tiles[xx][yy]->heights[ii];
+									avgs[i] += map->getGat()->tile(xx, yy).heights[ii];
 									count++;
 								}
 							}
@@ -191,7 +190,7 @@ void BrowEdit::gatEditUpdate()
 								int yy = y + (-(ii / 2)) + (i / 2);
 								if (map->inMap(xx, yy))
 								{
-									map->getGat()->tiles[xx][yy]->heights[ii] = avgs[i];
+									map->getGat()->tile(xx, yy).heights[ii] = avgs[i];
 									mapRenderer.setTileDirty(xx, yy);
 								}
 							}
@@ -204,11 +203,10 @@ void BrowEdit::gatEditUpdate()
 		if (keyState.isPressed(blib::Key::S) && !lastKeyState.isPressed(blib::Key::S))
 		{
 			std::map<glm::ivec2, float, bool(*)(const glm::ivec2&, const glm::ivec2&)> newHeights([](const glm::ivec2& a, const glm::ivec2& b){ return a.x + 5000 * a.y < b.x + 5000 * b.y; });
-			for (int x = 0; x < map->getGat()->width; x++)
+			for (int y = 0; y < map->getGat()->height; y++)
 			{
-				for (int y = 0; y < map->getGat()->height; y++)
+				for (int x = 0; x < map->getGat()->width; x++)
 				{
-					Gat::Tile* c = map->getGat()->tiles[x][y];
 					float avg = 0;
 					int count = 0;
 					for (int ii = 0; ii < 4; ii++)
@@ -217,19 +215,18 @@ void BrowEdit::gatEditUpdate()
 						int yy = y + (-(ii / 2));
 						if (map->inMap(xx, yy))
 						{
-							avg += map->getGat()->tiles[xx][yy]->heights[ii];
+							avg += map->getGat()->tile(xx, yy).heights[ii];
 							count++;
 						}
 					}
 					newHeights[glm::ivec2(x, y)] = avg / count;
 				}
 			}
-			for (int x = 0; x < map->getGat()->width; x++)
+			for (int y = 0; y < map->getGat()->height; y++)
 			{
-				for (int y = 0; y < map->getGat()->height; y++)
+				for (int x = 0; x < map->getGat()->width; x++)
 				{
-					Gat::Tile* c = map->getGat()->tiles[x][y];
-					if (!c->selected)
+					if (!map->getGat()->selected(x, y))
 						continue;
 					for (int ii = 0; ii < 4; ii++)
 					{
@@ -250,7 +247,7 @@ void BrowEdit::gatEditUpdate()
 									}
 								}
 							}
-							map->getGat()->tiles[xx][yy]->heights[ii] = total / count;
+							map->getGat()->tile(xx, yy).heights[ii] = total / count;
 							mapRenderer.setTileDirty(xx, yy);
 						}
 					}
@@ -262,28 +259,28 @@ void BrowEdit::gatEditUpdate()
 		{
 			float avg = 0;
 			int count = 0;
-			for (int x = 0; x < map->getGat()->width; x++)
+			for (int y = 0; y < map->getGat()->height; y++)
 			{
-				for (int y = 0; y < map->getGat()->height; y++)
+				for (int x = 0; x < map->getGat()->width; x++)
 				{
-					Gat::Tile* c = map->getGat()->tiles[x][y];
-					if (!c->selected)
+					if (!map->getGat()->selected(x, y))
 						continue;
+					Gat::Tile &c = map->getGat()->tile(x, y);
 					for (int i = 0; i < 4; i++)
-						avg += c->heights[i];
+						avg += c.heights[i];
 					count += 4;
 				}
 			}
 			avg /= count;
-			for (int x = 0; x < map->getGat()->width; x++)
+			for (int y = 0; y < map->getGat()->height; y++)
 			{
-				for (int y = 0; y < map->getGat()->height; y++)
+				for (int x = 0; x < map->getGat()->width; x++)
 				{
-					Gat::Tile* c = map->getGat()->tiles[x][y];
-					if (!c->selected)
+					if (!map->getGat()->selected(x, y))
 						continue;
+					Gat::Tile &c = map->getGat()->tile(x, y);
 					for (int i = 0; i < 4; i++)
-						c->heights[i] = avg;
+						c.heights[i] = avg;
 					mapRenderer.setTileDirty(x, y);
 				}
 			}
@@ -12,7 +12,7 @@ void BrowEdit::gatTypeEditUpdate()
 		int cursorY = map->getGat()->height + 1 - (int)glm::floor(mapRenderer.mouse3d.z / 5);
 		int mapHeight = map->getGat()->height;
 
-		map->getGat()->tiles[cursorX][cursorY]->type = activeGatTile;
+		map->getGat()->tile(cursorX, cursorY).type = activeGatTile;
 		mapRenderer.gatDirty = true;
 	}
 	for (char i = '0'; i <= '9'; i++)
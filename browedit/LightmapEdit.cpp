@@ -19,6 +19,15 @@ void BrowEdit::lightmapEditUpdate()
 	{
 		if (mouseState.position != lastMouseState.position || (mouseState.leftButton && !lastMouseState.leftButton) || (mouseState.rightButton && !lastMouseState.rightButton))
 		{
+			//lightmaps and tiles are shared between surfaces after loading, compacting or texturing, so every surface gets
+			//its own before it is painted. Adding them moves the lightmaps, so that waits until the lightmap texture is built
+			if (!map->getGnd()->lightmapsUnique())
+			{
+				if (mapRenderer.isShadowBuilding())
+					return;
+				map->getGnd()->makeLightmapsUnique();
+				mapRenderer.setAllDirty();
+			}
 			ShadowBrush& brush = shadowMapBrushes[shadowMapBrush];
 			int h = brush.brush.size();
 			int w = brush.brush[0].size();
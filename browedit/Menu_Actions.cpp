@@ -3,9 +3,11 @@
 #include "windows/TextureWindow.h"
 #include "windows/ObjectWindow.h"
 #include "windows/ProgressWindow.h"
+#include "windows/MessageWindow.h"
 
 #include <blib/util/Log.h>
 #include <blib/math/Triangle.h>
+#include <blib/Util.h>
 using blib::util::Log;
 
 #include <BroLib/Map.h>
@@ -18,6 +20,7 @@ void BrowEdit::menuActionsLightmapCalculate()
 {
 	if (!map)
 		return;
+	map->getRsw()->waitForModels(map->getGnd()); //every model has to cast its shadow
 
 
 	ProgressWindow* window = new ProgressWindow(resourceManager, this);
@@ -145,11 +148,11 @@ void BrowEdit::menuActionsLightmapCalculate()
 
 		auto calcPos = [this, quality, s, height, &calculateLight](int direction, int tileId, int x, int y)
 		{
-			Gnd::Tile* tile = map->getGnd()->tiles[tileId];
-			assert(tile && tile->lightmapIndex != -1);
-			Gnd::Lightmap* lightmap = map->getGnd()->lightmaps[tile->lightmapIndex];
+			Gnd::Tile &tile = map->getGnd()->tiles[tileId];
+			assert(tile.lightmapIndex != -1);
+			Gnd::Lightmap &lightmap = map->getGnd()->lightmaps[tile.lightmapIndex];
 
-			Gnd::Cube* cube = map->getGnd()->cubes[x][y];
+			Gnd::Cube cube = map->getGnd()->cube(x, y);
 
 			for (int xx = 1; xx < 7; xx++)
 			{
@@ -166,14 +169,14 @@ void BrowEdit::menuActionsLightmapCalculate()
 							//todo: use proper height using barycentric coordinats
 							if (direction == 0)
 							{
-								groundPos = glm::vec3(10 * x + s * ((xx + xxx) - 1), -(cube->h1 + cube->h2 + cube->h3 + cube->h4) / 4.0f, 10 * height + 10 - 10 * y - s * ((yy + yyy) - 1));
+								groundPos = glm::vec3(10 * x + s * ((xx + xxx) - 1), -(cube.h1 + cube.h2 + cube.h3 + cube.h4) / 4.0f, 10 * height + 10 - 10 * y - s * ((yy + yyy) - 1));
 								normal = glm::vec3(0, 1, 0);
 							}
 							else if (direction == 1) //side
 							{
-								auto otherCube = map->getGnd()->cubes[x][y + 1];
-								float h1 = glm::mix(cube->h3, cube->h4, ((xx + xxx) - 1) / 6.0f);
-								float h2 = glm::mix(otherCube->h2, otherCube->h1, ((xx + xxx) - 1) / 6.0f);
+								auto otherCube = map->getGnd()->cube(x, y + 1);
+								float h1 = glm::mix(cube.h3, cube.h4, ((xx + xxx) - 1) / 6.0f);
+								float h2 = glm::mix(otherCube.h2, otherCube.h1, ((xx + xxx) - 1) / 6.0f);
 								float h = glm::mix(h1, h2, ((yy + yyy) - 1) / 6.0f);
 
 								groundPos = glm::vec3(10 * x + s * ((xx + xxx) - 1), -h, 10 * height - 10 * y);
@@ -184,9 +187,9 @@ void BrowEdit::menuActionsLightmapCalculate()
 							}
 							else if (direction == 2) //front
 							{
-								auto otherCube = map->getGnd()->cubes[x + 1][y];
-								float h1 = glm::mix(cube->h2, cube->h4, ((xx + xxx) - 1) / 6.0f);
-								float h2 = glm::mix(otherCube->h1, otherCube->h3, ((xx + xxx) - 1) / 6.0f);
+								auto otherCube = map->getGnd()->cube(x + 1, y);
+								float h1 = glm::mix(cube.h2, cube.h4, ((xx + xxx) - 1) / 6.0f);
+								float h2 = glm::mix(otherCube.h1, otherCube.h3, ((xx + xxx) - 1) / 6.0f);
 								float h = glm::mix(h1, h2, ((yy + yyy) - 1) / 6.0f);
 
 								groundPos = glm::vec3(10 * x, -h, 10 * height + 10 - 10 * y + s * ((xx + xxx) - 1));
@@ -206,10 +209,10 @@ void BrowEdit::menuActionsLightmapCalculate()
 					if (intensity > 255)
 						intensity = 255;
 
-					lightmap->data[xx + 8 * yy] = intensity;
-					lightmap->data[64 + 3 * (xx + 8 * yy) + 0] = 0;
-					lightmap->data[64 + 3 * (xx + 8 * yy) + 1] = 0;
-					lightmap->data[64 + 3 * (xx + 8 * yy) + 2] = 0;
+					lightmap.data[xx + 8 * yy] = intensity;
+					lightmap.data[64 + 3 * (xx + 8 * yy) + 0] = 0;
+					lightmap.data[64 + 3 * (xx + 8 * yy) + 1] = 0;
+					lightmap.data[64 + 3 * (xx + 8 * yy) + 2] = 0;
 				}
 			}
 		};
@@ -233,11 +236,11 @@ void BrowEdit::menuActionsLightmapCalculate()
 					for (int y = 0; y < map->getGnd()->height; y++)
 						//for (int y = 0; y < 10; y++)
 					{
-						Gnd::Cube* cube = map->getGnd()->cubes[x][y];
+						Gnd::Cube cube = map->getGnd()->cube(x, y);
 
 						for (int i = 0; i < 3; i++)
-							if (cube->tileIds[i] != -1)
-								calcPos(i, cube->tileIds[i], x, y);
+							if (cube.tileIds[i] != -1)
+								calcPos(i, cube.tileIds[i], x, y);
 					}
 				}
 			}));
@@ -259,10 +262,10 @@ void BrowEdit::menuActionsLightmapCalculate()
 			t.join();
 
 
-		/*Gnd::Cube* cube = map->getGnd()->cubes[63][31];
+		/*Gnd::Cube cube = map->getGnd()->cube(63, 31);
 		for (int i = 0; i < 3; i++)
-			if (cube->tileIds[i] != -1)
-				calcPos(i, cube->tileIds[i], 63, 31);*/  //test single tile
+			if (cube.tileIds[i] != -1)
+				calcPos(i, cube.tileIds[i], 63, 31);*/  //test single tile
 
 
 		map->getGnd()->makeLightmapBorders();
@@ -298,6 +301,24 @@ void BrowEdit::menuActionsLightmapUnique()
 	mapRenderer.setAllDirty();
 }
 
+void BrowEdit::menuActionsLightmapCompact()
+{
+	if (!map)
+		return;
+	//compacting moves the lightmaps, which may still be read while the lightmap texture is built
+	if (mapRenderer.isShadowBuilding())
+	{
+		new MessageWindow(resourceManager, "The map is still being built, try again in a moment", "Compact");
+		return;
+	}
+	Gnd* gnd = map->getGnd();
+	size_t lightmapCount = gnd->lightmaps.size();
+	size_t tileCount = gnd->tiles.size();
+	size_t saved = gnd->compact();
+	mapRenderer.setAllDirty();
+	new MessageWindow(resourceManager, "Removed " + blib::util::toString(lightmapCount - gnd->lightmaps.size()) + " lightmaps and " + blib::util::toString(tileCount - gnd->tiles.size()) + " tiles, saving " + blib::util::toString(saved / 1024) + "kb", "Compact");
+}
+
 
 
 
@@ -306,8 +327,7 @@ void BrowEdit::menuActionsScaleDown()
 	Map* newMap = new Map("", map->getGnd()->width / 2, map->getGnd()->height / 2);
 	newMap->getRsw()->water = map->getRsw()->water;
 
-	for (auto l : map->getGnd()->lightmaps)
-		newMap->getGnd()->lightmaps.push_back(new Gnd::Lightmap(*l));
+	newMap->getGnd()->lightmaps = map->getGnd()->lightmaps;
 
 	for (auto t : map->getGnd()->textures)
 	{
@@ -322,26 +342,26 @@ void BrowEdit::menuActionsScaleDown()
 	{
 		for (int y = 0; y < newMap->getGnd()->height; y++)
 		{
-			if (map->getGnd()->cubes[x * 2][y * 2]->tileUp != -1)
+			if (map->getGnd()->cube(x * 2, y * 2).tileUp != -1)
 			{
-				Gnd::Tile* oldTile = map->getGnd()->tiles[map->getGnd()->cubes[x * 2][y * 2]->tileUp];
-				Gnd::Tile* t = new Gnd::Tile();
-				t->textureIndex = oldTile->textureIndex;
-				t->lightmapIndex = oldTile->lightmapIndex;
-				t->color = oldTile->color;
+				Gnd::Tile &oldTile = map->getGnd()->tiles[map->getGnd()->cube(x * 2, y * 2).tileUp];
+				Gnd::Tile t;
+				t.textureIndex = oldTile.textureIndex;
+				t.lightmapIndex = oldTile.lightmapIndex;
+				t.color = oldTile.color;
 
-				t->v1 = oldTile->v1;
-				t->v2 = map->getGnd()->tiles[map->getGnd()->cubes[x * 2 + 1][y * 2]->tileUp]->v2;
-				t->v3 = map->getGnd()->tiles[map->getGnd()->cubes[x * 2][y * 2 + 1]->tileUp]->v3;
-				t->v4 = map->getGnd()->tiles[map->getGnd()->cubes[x * 2 + 1][y * 2 + 1]->tileUp]->v4;
+				t.v1 = oldTile.v1;
+				t.v2 = map->getGnd()->tiles[map->getGnd()->cube(x * 2 + 1, y * 2).tileUp].v2;
+				t.v3 = map->getGnd()->tiles[map->getGnd()->cube(x * 2, y * 2 + 1).tileUp].v3;
+				t.v4 = map->getGnd()->tiles[map->getGnd()->cube(x * 2 + 1, y * 2 + 1).tileUp].v4;
 
 				newMap->getGnd()->tiles.push_back(t);
 
-				newMap->getGnd()->cubes[x][y]->tileUp = newMap->getGnd()->tiles.size() - 1;
-				newMap->getGnd()->cubes[x][y]->h1 = map->getGnd()->cubes[x * 2][y * 2]->h1;
-				newMap->getGnd()->cubes[x][y]->h2 = map->getGnd()->cubes[x * 2 + 1][y * 2]->h2;
-				newMap->getGnd()->cubes[x][y]->h3 = map->getGnd()->cubes[x * 2][y * 2 + 1]->h3;
-				newMap->getGnd()->cubes[x][y]->h4 = map->getGnd()->cubes[x * 2 + 1][y * 2 + 1]->h4;
+				newMap->getGnd()->cube(x, y).tileUp = newMap->getGnd()->tiles.size() - 1;
+				newMap->getGnd()->cube(x, y).h1 = map->getGnd()->cube(x * 2, y * 2).h1;
+				newMap->getGnd()->cube(x, y).h2 = map->getGnd()->cube(x * 2 + 1, y * 2).h2;
+				newMap->getGnd()->cube(x, y).h3 = map->getGnd()->cube(x * 2, y * 2 + 1).h3;
+				newMap->getGnd()->cube(x, y).h4 = map->getGnd()->cube(x * 2 + 1, y * 2 + 1).h4;
 			}
 
 		}
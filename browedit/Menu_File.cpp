@@ -1,6 +1,7 @@
 #include "BrowEdit.h"
 
 #include "windows/MessageWindow.h"
+#include "windows/ProgressWindow.h"
 
 #include <BroLib/Map.h>
 
@@ -11,31 +12,11 @@
 #include <direct.h>
 
 
-void BrowEdit::menuFileSave()
-{
-	MessageWindow* dialog = new MessageWindow(resourceManager, "Saving...", "Saving");
-	new blib::BackgroundTask<bool>(this, [this]()
-	{
-		if (map)
-		{
-			char prevDir[1024];
-			_getcwd(prevDir, 1024);
-			_chdir(blib::util::replace(config["data"]["ropath"].get<std::string>(), "/", "\\").c_str());
-			map->save(map->getFileName());
-			_chdir(prevDir);
-		}
-		return true;
-	}, [dialog](bool bla)
-	{
-		dialog->close();
-	});
-}
-
-
-void BrowEdit::menuFileSaveAs()
+//shows the save dialog, and returns the chosen file, or an empty string if the dialog was cancelled
+std::string BrowEdit::askSaveFileName(const std::string &initialFileName, const char* filter, const char* defaultExtension, bool overwritePrompt)
 {
 	char fileName[1024];
-	strcpy(fileName, blib::util::replace(map->getFileName(), "/", "\\").c_str());
+	strcpy(fileName, initialFileName.c_str());
 
 	char curdir[100];
 	_getcwd(curdir, 100);
@@ -46,36 +27,77 @@ void BrowEdit::menuFileSaveAs()
 	ofn.hwndOwner = hWnd;
 	ofn.lpstrFile = fileName;
 	ofn.nMaxFile = 1024;
-	ofn.lpstrFilter = "All\0*.*\0RO maps\0*.rsw\0";
+	ofn.lpstrFilter = filter;
 	ofn.nFilterIndex = 2;
 	ofn.lpstrFileTitle = NULL;
 	ofn.nMaxFileTitle = 0;
 	ofn.lpstrInitialDir = NULL;
-	ofn.Flags = OFN_PATHMUSTEXIST | OFN_ENABLESIZING | OFN_OVERWRITEPROMPT;
-	if (GetSaveFileName(&ofn))
+	ofn.lpstrDefExt = defaultExtension;
+	ofn.Flags = OFN_PATHMUSTEXIST | OFN_ENABLESIZING | (overwritePrompt ? OFN_OVERWRITEPROMPT : 0);
+	bool ok = GetSaveFileName(&ofn) != 0;
+	_chdir(curdir);
+	return ok ? fileName : "";
+}
+
+//copies the map, and writes it to fileName, or into grfFile if it is set, in the background while editing goes on
+void BrowEdit::saveInBackground(const std::string &fileName, const std::string &grfFile)
+{
+	if (!map || saving)
+		return;
+	saving = true;
+	Map::SaveState* state = map->prepareSave(fileName);
+	ProgressWindow* window = new ProgressWindow(resourceManager, this);
+	window->setProgress(0);
+	new blib::BackgroundTask<bool>(this, [this, state, window, grfFile]()
+	{
+		char prevDir[1024];
+		_getcwd(prevDir, 1024);
+		_chdir(blib::util::replace(config["data"]["ropath"].get<std::string>(), "/", "\\").c_str());
+		auto progress = [window](float progress) { window->setProgress(progress * 100); };
+		bool ok = grfFile.empty() ? state->write(progress) : state->writeToGrf(grfFile, progress);
+		_chdir(prevDir);
+		return ok;
+	}, [this, state, window, grfFile](bool ok)
 	{
-		std::string newFileName(fileName);
-		newFileName = blib::util::replace(newFileName, "/", "\\");
-		if (newFileName.rfind(".") > newFileName.rfind("\\"))
-			newFileName = newFileName.substr(0, newFileName.rfind("."));
-		_chdir(curdir);
+		delete state;
+		saving = false;
+		window->close();
+		if (!ok)
+			new MessageWindow(resourceManager, grfFile.empty() ? "Unable to save the map, see the log for details" : "Unable to save the map into the grf, see the log for details", "Error");
+	});
+}
 
 
-		MessageWindow* dialog = new MessageWindow(resourceManager, "Saving...", "Saving");
-		new blib::BackgroundTask<bool>(this, [this, newFileName]()
-		{
-			if (map)
-				map->save(newFileName);
-			return true;
-		}, [dialog](bool bla)
-		{
-			dialog->close();
-		});
-	}
-	_chdir(curdir);
+void BrowEdit::menuFileSave()
+{
+	if (!map || saving)
+		return;
+	saveInBackground(map->getFileName());
 }
 
 
+void BrowEdit::menuFileSaveAs()
+{
+	if (!map || saving)
+		return;
+	std::string newFileName = askSaveFileName(blib::util::replace(map->getFileName(), "/", "\\"), "All\0*.*\0RO maps\0*.rsw\0", NULL, true);
+	if (newFileName.empty())
+		return;
+	newFileName = blib::util::replace(newFileName, "/", "\\");
+	if (newFileName.rfind(".") > newFileName.rfind("\\"))
+		newFileName = newFileName.substr(0, newFileName.rfind("."));
+	saveInBackground(newFileName);
+}
+
+
+void BrowEdit::menuFileSaveIntoGrf()
+{
+	if (!map || saving)
+		return;
+	std::string grfFile = askSaveFileName("", "All\0*.*\0GRF archives\0*.grf\0", "grf", false);
+	if (!grfFile.empty())
+		saveInBackground("", grfFile);
+}
 
 
 
@@ -1,35 +1,41 @@
-#include "TextureEditAction.h"
-#include <BroLib/Map.h>
-#include <BroLib/MapRenderer.h>
-
-
-
-void TextureAction::addTile(int x, int y, const Gnd::Tile &tile)
-{
-	data.push_back(Data(x,y,tile));
-}
-
-void TextureAction::perform(Map* map, MapRenderer& mapRenderer)
-{
-	for (std::list<Data>::iterator it = data.begin(); it != data.end(); it++)
-	{
-		Gnd::Cube* cube = map->getGnd()->cubes[it->x][it->y];
-		undodata.push_back(UndoData(it->x, it->y, cube->tileUp));
-		cube->tileUp = map->getGnd()->tiles.size();
-		map->getGnd()->tiles.push_back(new Gnd::Tile(it->tile));
-		mapRenderer.setTileDirty(it->x, it->y);
-	}
-
-}
-
-void TextureAction::undo(Map* map, MapRenderer& mapRenderer)
-{
-	for (std::list<UndoData>::iterator it = undodata.begin(); it != undodata.end(); it++)
-	{
-		map->getGnd()->cubes[it->x][it->y]->tileUp = it->oldTile;
-		mapRenderer.setTileDirty(it->x, it->y);
-	}
-	map->getGnd()->tiles.erase(map->getGnd()->tiles.end() - undodata.size(), map->getGnd()->tiles.end());
-	undodata.clear();
-}
-
+#include "TextureEditAction.h"
+#include <BroLib/Map.h>
+#include <BroLib/MapRenderer.h>
+
+
+
+void TextureAction::addTile(int x, int y, const Gnd::Tile &tile)
+{
+	data.push_back(Data(x,y,tile));
+}
+
+void TextureAction::perform(Map* map, MapRenderer& mapRenderer)
+{
+	Gnd* gnd = map->getGnd();
+	for (std::list<Data>::iterator it = data.begin(); it != data.end(); it++)
+	{
+		Gnd::Cube cube = gnd->cube(it->x, it->y);
+		if (cube.tileUp != -1)
+			undodata.push_back(UndoData(it->x, it->y, true, gnd->tiles[cube.tileUp]));
+		else
+			undodata.push_back(UndoData(it->x, it->y, false, it->tile));
+		cube.tileUp = gnd->addTile(it->tile);
+		mapRenderer.setTileDirty(it->x, it->y);
+	}
+	//the tiles that were painted over stay behind, they're cleaned up once enough of them pile up
+	if (gnd->tilesNeedSweep())
+		gnd->sweepTiles();
+}
+
+void TextureAction::undo(Map* map, MapRenderer& mapRenderer)
+{
+	Gnd* gnd = map->getGnd();
+	for (std::list<UndoData>::iterator it = undodata.begin(); it != undodata.end(); it++)
+	{
+		gnd->cube(it->x, it->y).tileUp = it->hadTile ? gnd->addTile(it->oldTile) : -1;
+		mapRenderer.setTileDirty(it->x, it->y);
+	}
+	undodata.clear();
+	if (gnd->tilesNeedSweep())
+		gnd->sweepTiles();
+}
@@ -1,46 +1,49 @@
-#pragma once
-
-#include "../action.h"
-#include <BroLib/Gnd.h>
-#include <list>
-
-class TextureAction : public Action
-{
-	class Data
-	{
-	public:
-		int x;
-		int y;
-		Gnd::Tile tile;
-
-		Data(int x, int y, const Gnd::Tile& tile)
-		{
-			this->x = x;
-			this->y = y;
-			this->tile = tile;
-		}
-	};
-
-	class UndoData
-	{
-	public:
-		int x;
-		int y;
-		int oldTile;
-
-		UndoData(int x, int y, int oldTile)
-		{
-			this->x = x;
-			this->y = y;
-			this->oldTile = oldTile;
-		}
-	};
-
-	std::list<Data> data;
-	std::list<UndoData> undodata;
-public:
-	void addTile(int x, int y, const Gnd::Tile &tile);
-
-	virtual void perform(Map* map, MapRenderer& mapRenderer);
-	virtual void undo(Map* map, MapRenderer& mapRenderer);
+#pragma once
+
+#include "../action.h"
+#include <BroLib/Gnd.h>
+#include <list>
+
+class TextureAction : public Action
+{
+	class Data
+	{
+	public:
+		int x;
+		int y;
+		Gnd::Tile tile;
+
+		Data(int x, int y, const Gnd::Tile& tile)
+		{
+			this->x = x;
+			this->y = y;
+			this->tile = tile;
+		}
+	};
+
+	//the old tile is kept by value, tile indices change when the gnd's tiles are swept
+	class UndoData
+	{
+	public:
+		int x;
+		int y;
+		bool hadTile;
+		Gnd::Tile oldTile;
+
+		UndoData(int x, int y, bool hadTile, const Gnd::Tile& oldTile)
+		{
+			this->x = x;
+			this->y = y;
+			this->hadTile = hadTile;
+			this->oldTile = oldTile;
+		}
+	};
+
+	std::list<Data> data;
+	std::list<UndoData> undodata;
+public:
+	void addTile(int x, int y, const Gnd::Tile &tile);
+
+	virtual void perform(Map* map, MapRenderer& mapRenderer);
+	virtual void undo(Map* map, MapRenderer& mapRenderer);
 };
\ No newline at end of file
@@ -1 +1 @@
-329
+329
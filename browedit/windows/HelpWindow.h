@@ -1,14 +1,14 @@
-#pragma once
-
-#include <blib/wm/Window.h>
-
-
-class BrowEdit;
-
-class HelpWindow : public blib::wm::Window
-{
-public:
-	HelpWindow(blib::ResourceManager* resourceManager, BrowEdit* browEdit);
-
-
+#pragma once
+
+#include <blib/wm/Window.h>
+
+
+class BrowEdit;
+
+class HelpWindow : public blib::wm::Window
+{
+public:
+	HelpWindow(blib::ResourceManager* resourceManager, BrowEdit* browEdit);
+
+
 };
\ No newline at end of file
@@ -1,14 +1,14 @@
-#pragma once
-
-#include <blib/wm/Window.h>
-
-
-class BrowEdit;
-
-class NewMapWindow : public blib::wm::Window
-{
-public:
-	NewMapWindow(blib::ResourceManager* resourceManager, BrowEdit* browEdit);
-
-
+#pragma once
+
+#include <blib/wm/Window.h>
+
+
+class BrowEdit;
+
+class NewMapWindow : public blib::wm::Window
+{
+public:
+	NewMapWindow(blib::ResourceManager* resourceManager, BrowEdit* browEdit);
+
+
 };
\ No newline at end of file